@@ -1,7 +1,9 @@
 #define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
 #include <string.h>
 #include "abb.h"
-#include "pila.h"
+#include "bloom.h"
+#include "intern.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -10,44 +12,139 @@ typedef struct nodo_abb{
     struct nodo_abb* der;
     char* clave;
     void* dato;
+    int altura; // Altura del subárbol que empieza en el nodo (1 para una hoja).
+    bool en_bloque; // El nodo está en un bloque_nodos_t y no se libera solo.
+    size_t tam; // Cantidad de nodos del subárbol que empieza en el nodo.
 }nodo_abb_t;
+
+// Bloque de nodos pedido de una sola vez por abb_crear_desde_ordenado. Sus nodos (y sus
+// claves, que van a continuación) no se liberan uno por uno: el bloque entero se libera
+// al destruir el abb.
+typedef struct bloque_nodos{
+    struct bloque_nodos* sig;
+    nodo_abb_t nodos[];
+}bloque_nodos_t;
  
-nodo_abb_t* crear_nodo_abb(const char* clave, void* dato){
+// Copia la clave, o devuelve su copia canónica si el árbol toma las claves de un intern_t.
+static char* copiar_clave_abb(intern_t* intern, const char* clave){
+    // La copia del intern_t nunca se modifica: el nodo sólo la lee.
+    if (intern) return (char*) intern_agregar(intern, clave);
+    return strdup(clave);
+}
+
+// Libera la clave si no era prestada de un intern_t.
+static void liberar_clave_abb(const intern_t* intern, char* clave){
+    if (!intern) free(clave);
+}
+
+// Compara las claves, sin llamar a la función de comparación si son el mismo puntero
+// (lo que pasa seguido con claves de un intern_t).
+static int comparar_claves(abb_comparar_clave_t cmp, const char* clave1, const char* clave2){
+    if (clave1 == clave2) return 0;
+    return cmp(clave1, clave2);
+}
+
+nodo_abb_t* crear_nodo_abb(const char* clave, void* dato, intern_t* intern){
     nodo_abb_t* nodo = malloc(sizeof(nodo_abb_t));
     if (!nodo) return NULL;
     nodo->izq = NULL;
     nodo->der = NULL;
-    nodo->clave = strdup(clave);
+    nodo->clave = copiar_clave_abb(intern, clave);
     if (!nodo->clave){
         free(nodo);
         return NULL;
     }
     nodo->dato = dato;
+    nodo->altura = 1;
+    nodo->en_bloque = false;
+    nodo->tam = 1;
     return nodo;
 }
 
+// El árbol es un AVL: en cada nodo, las alturas de sus dos subárboles difieren a lo
+// sumo en uno, por lo que la altura del árbol es O(log n).
 struct abb{
     nodo_abb_t* raiz;
     size_t cant;
     abb_destruir_dato_t destruir;
     abb_comparar_clave_t comparar;
+    intern_t* intern;
+    bloom_t* filtro;
+    double tasa_filtro;
+    bloque_nodos_t* bloques;
 };
 
-abb_t* abb_crear(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato){
+#define CAPACIDAD_FILTRO 16 // Capacidad mínima del filtro de Bloom del abb.
+
+abb_t* abb_crear_con_opciones(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato, const abb_opciones_t* opciones){
     abb_t* abb = malloc(sizeof(abb_t));
     if (!abb) return NULL;
     abb->raiz = NULL;
     abb->cant = 0;
     abb->destruir = destruir_dato;
     abb->comparar = cmp;
+    abb->intern = opciones ? opciones->intern : NULL;
+    abb->tasa_filtro = opciones ? opciones->tasa_falsos_positivos : 0;
+    abb->filtro = NULL;
+    abb->bloques = NULL;
+    if (abb->tasa_filtro != 0){
+        abb->filtro = bloom_crear(CAPACIDAD_FILTRO, abb->tasa_filtro);
+        if (!abb->filtro){
+            free(abb);
+            return NULL;
+        }
+    }
     return abb;
 }
 
-// Destruye el nodo y devuelve su dato.
-void* destruir_nodo(nodo_abb_t* nodo){
+abb_t* abb_crear_con_intern(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato, intern_t* intern){
+    abb_opciones_t opciones = {.intern = intern};
+    return abb_crear_con_opciones(cmp, destruir_dato, &opciones);
+}
+
+abb_t* abb_crear(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato){
+    return abb_crear_con_opciones(cmp, destruir_dato, NULL);
+}
+
+// Devuelve false si el filtro del abb asegura que la clave no está.
+static bool puede_estar(const abb_t* abb, const char* clave){
+    return !abb->filtro || bloom_contiene(abb->filtro, clave);
+}
+
+// Agrega al filtro las claves del subárbol.
+static void agregar_nodos_filtro(bloom_t* filtro, nodo_abb_t* nodo){
+    if (!nodo) return;
+    bloom_agregar(filtro, nodo->clave);
+    agregar_nodos_filtro(filtro, nodo->izq);
+    agregar_nodos_filtro(filtro, nodo->der);
+}
+
+// Cuando el filtro se llena (cuenta también las claves ya borradas) lo arma de nuevo con
+// las claves vigentes y lugar para el doble; si no hay memoria se sigue con el actual,
+// que contiene a todas las claves.
+static void rearmar_filtro_si_lleno(abb_t* abb){
+    if (bloom_cantidad(abb->filtro) <= bloom_capacidad(abb->filtro)) return;
+    size_t capacidad = 2 * abb->cant > CAPACIDAD_FILTRO ? 2 * abb->cant : CAPACIDAD_FILTRO;
+    bloom_t* filtro = bloom_crear(capacidad, abb->tasa_filtro);
+    if (!filtro) return;
+    agregar_nodos_filtro(filtro, abb->raiz);
+    bloom_destruir(abb->filtro);
+    abb->filtro = filtro;
+}
+
+// Agrega la clave nueva al filtro.
+static void agregar_a_filtro(abb_t* abb, const char* clave){
+    bloom_agregar(abb->filtro, clave);
+    rearmar_filtro_si_lleno(abb);
+}
+
+// Destruye el nodo y devuelve su dato. Los nodos de un bloque se liberan con el bloque.
+void* destruir_nodo(nodo_abb_t* nodo, const intern_t* intern){
     void* dato = nodo->dato;
-    free(nodo->clave); 
-    free(nodo);
+    if (!nodo->en_bloque){
+        liberar_clave_abb(intern, nodo->clave);
+        free(nodo);
+    }
     return dato;
 }
 
@@ -56,204 +153,389 @@ size_t abb_cantidad(abb_t *arbol){
 }
 
 nodo_abb_t* buscar_nodo(abb_comparar_clave_t cmp, nodo_abb_t* nodo, const char* clave){
-    if (!nodo) return NULL;
-    int comparacion = cmp(nodo->clave, clave);
-    if (comparacion == 0){
-        return nodo;
-    }
-    if (comparacion > 0){
-        return buscar_nodo(cmp, nodo->izq, clave);
+    while (nodo){
+        int comparacion = comparar_claves(cmp, nodo->clave, clave);
+        if (comparacion == 0) return nodo;
+        nodo = comparacion > 0 ? nodo->izq : nodo->der;
     }
-    return buscar_nodo(cmp, nodo->der, clave);
+    return NULL;
 }
 
-// Devuelve el padre del nodo, o NULL en caso de que no haya raíz.
-nodo_abb_t* buscar_padre(abb_comparar_clave_t cmp, nodo_abb_t *nodo, const char *clave){
-    if (!nodo) return NULL;
-    int comparacion = cmp(nodo->clave, clave);
-    if (comparacion < 0){
-        if(!nodo->der || cmp(nodo->der->clave,clave) == 0){return nodo;}
-        return buscar_padre(cmp, nodo->der, clave);
-    }
-    if (comparacion > 0){
-        if(!nodo->izq || cmp(nodo->izq->clave,clave) == 0){return nodo;}
-        return buscar_padre(cmp, nodo->izq, clave);
-    }
-    return nodo; 
+// Reemplaza el dato en un nodo, borrando el dato anterior si es que el árbol tiene función de destrucción.
+void reemplazar_dato(nodo_abb_t* nodo, const abb_t* abb, void* dato){
+    if (abb->destruir) abb->destruir(nodo->dato);
+    nodo->dato = dato;
 }
 
-// Reemplaza el dato en un nodo, borrando el dato anterior si es que el árbol tiene función de destrucción.
-void reemplazar_dato(nodo_abb_t* nodo, abb_destruir_dato_t destruir, nodo_abb_t* nuevo_nodo){
-    void* dato = nodo->dato;
-    if (destruir) destruir(dato);
-    nodo->dato = destruir_nodo(nuevo_nodo);
+/*FUNCIONES AUXILIARES PARA BALANCEAR (AVL)*/
+
+// Devuelve la altura del subárbol (0 si está vacío).
+static int altura(const nodo_abb_t* nodo){
+    return nodo ? nodo->altura : 0;
+}
+
+// Devuelve la cantidad de nodos del subárbol (0 si está vacío).
+static size_t tam(const nodo_abb_t* nodo){
+    return nodo ? nodo->tam : 0;
+}
+
+// Recalcula la altura y el tamaño del nodo a partir de los de sus hijos.
+static void actualizar_altura(nodo_abb_t* nodo){
+    int izq = altura(nodo->izq);
+    int der = altura(nodo->der);
+    nodo->altura = (izq > der ? izq : der) + 1;
+    nodo->tam = tam(nodo->izq) + tam(nodo->der) + 1;
+}
+
+// Rota el subárbol hacia la derecha y devuelve su nueva raíz (el hijo izquierdo).
+static nodo_abb_t* rotar_derecha(nodo_abb_t* nodo){
+    nodo_abb_t* hijo = nodo->izq;
+    nodo->izq = hijo->der;
+    hijo->der = nodo;
+    actualizar_altura(nodo);
+    actualizar_altura(hijo);
+    return hijo;
+}
+
+// Rota el subárbol hacia la izquierda y devuelve su nueva raíz (el hijo derecho).
+static nodo_abb_t* rotar_izquierda(nodo_abb_t* nodo){
+    nodo_abb_t* hijo = nodo->der;
+    nodo->der = hijo->izq;
+    hijo->izq = nodo;
+    actualizar_altura(nodo);
+    actualizar_altura(hijo);
+    return hijo;
 }
 
-// Actualiza al hijo derecho o izquierdo del padre, o a la raíz del árbol.
-void actualizar_nodo(nodo_abb_t* nodo, abb_t* abb, nodo_abb_t* nuevo_nodo, size_t pos){
-    if (pos == 0){
-        nodo->izq = nuevo_nodo;
+// Recalcula la altura del nodo y, si las alturas de sus hijos difieren en más de uno,
+// lo rota (dos veces si el hijo más alto está inclinado hacia el otro lado).
+// Devuelve la nueva raíz del subárbol.
+static nodo_abb_t* balancear(nodo_abb_t* nodo){
+    actualizar_altura(nodo);
+    int factor = altura(nodo->izq) - altura(nodo->der);
+    if (factor > 1){
+        if (altura(nodo->izq->izq) < altura(nodo->izq->der)) nodo->izq = rotar_izquierda(nodo->izq);
+        return rotar_derecha(nodo);
     }
-    if (pos == 1){
-        abb->raiz = nuevo_nodo;
+    if (factor < -1){
+        if (altura(nodo->der->der) < altura(nodo->der->izq)) nodo->der = rotar_derecha(nodo->der);
+        return rotar_izquierda(nodo);
     }
-    if (pos == 2){
-        nodo->der = nuevo_nodo;
+    return nodo;
+}
+
+// Camino desde la raíz hasta un nodo: en cada nivel, el enlace (la raíz del árbol o el
+// hijo izquierdo o derecho del padre) por el que se bajó.
+// Un AVL de altura h tiene al menos fib(h + 2) - 1 nodos, así que con menos de 2^64
+// nodos la altura es menor que 93.
+#define ALTURA_MAX 96
+
+typedef struct camino{
+    nodo_abb_t** enlaces[ALTURA_MAX];
+    size_t largo;
+}camino_t;
+
+// Suma el nodo agregado (o resta el borrado) al tamaño de todos los subárboles del camino.
+static void ajustar_tam_camino(const camino_t* camino, bool agregado){
+    for (size_t i = 0; i < camino->largo; i++){
+        if (agregado) (*camino->enlaces[i])->tam ++;
+        else (*camino->enlaces[i])->tam --;
     }
-    abb->cant ++;
 }
 
-// Guarda la nueva hoja (si es que la clave nueva no estaba en el arbol) actualizando el nodo del padre.
-// Si la clave ya existía, actualiza su dato y destruye el nuevo nodo (El reemplazo es en el nodo ya existente).
-void guardar_hoja(nodo_abb_t* padre, nodo_abb_t* nuevo_nodo, abb_t* arbol, const char* clave){
-    int comparacion = arbol->comparar(padre->clave, clave);
-    if (comparacion < 0){
-        if (!padre->der){
-            actualizar_nodo(padre, arbol, nuevo_nodo, 2);
-        }else{
-            reemplazar_dato(padre->der, arbol->destruir, nuevo_nodo);
-        }
-    }else{ 
-        if (!padre->izq){
-            actualizar_nodo(padre, arbol, nuevo_nodo, 0);
-        }else{
-            reemplazar_dato(padre->izq, arbol->destruir, nuevo_nodo);
-        }
+// Rebalancea los subárboles del camino, del más profundo a la raíz. Si un subárbol
+// quedó con la misma altura que tenía, los de arriba no cambian y se termina antes
+// (sus tamaños ya se ajustaron con ajustar_tam_camino).
+static void rebalancear_camino(camino_t* camino){
+    while (camino->largo > 0){
+        nodo_abb_t** enlace = camino->enlaces[--camino->largo];
+        int altura_anterior = (*enlace)->altura;
+        *enlace = balancear(*enlace);
+        if ((*enlace)->altura == altura_anterior) return;
     }
 }
 
-bool abb_guardar(abb_t *arbol, const char *clave, void *dato){
-    nodo_abb_t* nuevo_nodo = crear_nodo_abb(clave, dato);
-    if (!nuevo_nodo) return false;
-    nodo_abb_t* padre = buscar_padre(arbol->comparar, arbol->raiz, clave);
-    if (!padre){
-        actualizar_nodo(arbol->raiz, arbol, nuevo_nodo, 1);
+// Baja desde la raíz hasta la clave guardando el camino, sin incluir el enlace final.
+// Devuelve el enlace al nodo de la clave, o el enlace vacío donde iría si no está.
+static nodo_abb_t** bajar_hasta(abb_t* abb, const char* clave, camino_t* camino){
+    nodo_abb_t** enlace = &abb->raiz;
+    camino->largo = 0;
+    while (*enlace){
+        int comparacion = comparar_claves(abb->comparar, (*enlace)->clave, clave);
+        if (comparacion == 0) break;
+        camino->enlaces[camino->largo++] = enlace;
+        enlace = comparacion > 0 ? &(*enlace)->izq : &(*enlace)->der;
     }
-    else if (!strcmp(arbol->raiz->clave, clave)){
-        reemplazar_dato(arbol->raiz, arbol->destruir, nuevo_nodo);
-    }else{
-        guardar_hoja(padre, nuevo_nodo, arbol, clave);
+    return enlace;
+}
+
+bool abb_guardar(abb_t *arbol, const char *clave, void *dato){
+    camino_t camino;
+    nodo_abb_t** enlace = bajar_hasta(arbol, clave, &camino);
+    if (*enlace){
+        reemplazar_dato(*enlace, arbol, dato);
+        return true;
     }
+
+    // Sólo se pide memoria cuando la clave es nueva.
+    nodo_abb_t* nuevo_nodo = crear_nodo_abb(clave, dato, arbol->intern);
+    if (!nuevo_nodo) return false;
+    *enlace = nuevo_nodo;
+    arbol->cant ++;
+    ajustar_tam_camino(&camino, true);
+    rebalancear_camino(&camino);
+    if (arbol->filtro) agregar_a_filtro(arbol, clave);
     return true;
 }
 
 void* abb_obtener(const abb_t* arbol, const char* clave){
+    if (!puede_estar(arbol, clave)) return NULL;
     nodo_abb_t* nodo = buscar_nodo(arbol->comparar, arbol->raiz, clave);
     if(!nodo) return NULL;
     return nodo->dato;
 }
 
 bool abb_pertenece(const abb_t* arbol, const char* clave){
+    if (!puede_estar(arbol, clave)) return false;
     nodo_abb_t* nodo = buscar_nodo(arbol->comparar, arbol->raiz, clave);
     return (nodo != NULL);
 }
 
 /*FUNCIONES AUXILIARES PARA BORRAR UN NODO*/
 
-// Devuelve la cantidad de hijos del nodo.
-int calcular_hijos(nodo_abb_t* nodo){
-    int res = 0;
-    if(nodo->izq) res += 1;
-    if(nodo->der) res += 1;
-    return res;
-}
-
 // Pre: El nodo tiene uno o ningún hijo.
 // Devuelve algún hijo (NULL si no tiene ninguno).
-nodo_abb_t* buscar_hijo(nodo_abb_t* nodo){
+static nodo_abb_t* buscar_hijo(nodo_abb_t* nodo){
     if (!nodo->izq) return nodo->der;
     return nodo->izq;
 }
 
-// Devuelve el nodo reemplazante para el caso de borrar con dos hijos.
-nodo_abb_t* buscar_reemplazante(nodo_abb_t* nodo){
-    nodo_abb_t* actual = nodo;
-    if (actual) actual = actual->der;
-    while (actual && actual->izq){ 
-        actual = actual->izq;
+// Caso de borrar en el que el nodo tiene dos hijos: su reemplazante (el menor de su
+// subárbol derecho) se desengancha de donde estaba y ocupa su lugar, así que no se
+// copia ninguna clave. El camino sigue hasta el padre del reemplazante.
+static void reemplazar_por_sucesor(nodo_abb_t** enlace, camino_t* camino){
+    nodo_abb_t* nodo = *enlace;
+    size_t pos_nodo = camino->largo;
+    camino->enlaces[camino->largo++] = enlace;
+    nodo_abb_t** enlace_reemplazante = &nodo->der;
+    while ((*enlace_reemplazante)->izq){
+        camino->enlaces[camino->largo++] = enlace_reemplazante;
+        enlace_reemplazante = &(*enlace_reemplazante)->izq;
     }
-    return actual;
+    nodo_abb_t* reemplazante = *enlace_reemplazante;
+    *enlace_reemplazante = reemplazante->der;
+
+    reemplazante->izq = nodo->izq;
+    reemplazante->der = nodo->der;
+    reemplazante->altura = nodo->altura;
+    reemplazante->tam = nodo->tam;
+    *enlace = reemplazante;
+    // El primer enlace que se guardó debajo del nodo borrado era su hijo derecho.
+    if (camino->largo > pos_nodo + 1) camino->enlaces[pos_nodo + 1] = &reemplazante->der;
 }
 
-// Caso de borrar en el que el nodo no tiene hijos.
-void* borrar_hoja(abb_t* abb, nodo_abb_t* nodo, nodo_abb_t* padre, int comparacion){
-    //int comparacion = abb->comparar(nodo->clave, padre->clave);
-    if (comparacion == 0){
-        abb->raiz = buscar_hijo(nodo);
+void *abb_borrar(abb_t *arbol, const char *clave){
+    if (!puede_estar(arbol, clave)) return NULL;
+    camino_t camino;
+    nodo_abb_t** enlace = bajar_hasta(arbol, clave, &camino);
+    nodo_abb_t* nodo = *enlace;
+    if (!nodo) return NULL;
+
+    if (nodo->izq && nodo->der){
+        reemplazar_por_sucesor(enlace, &camino);
     }else{
-        if (comparacion > 0){
-            padre->der = NULL;
+        // Caso de borrar en el que el nodo tiene uno o ningún hijo: el hijo ocupa su lugar.
+        *enlace = buscar_hijo(nodo);
+    }
+    arbol->cant --;
+    ajustar_tam_camino(&camino, false);
+    rebalancear_camino(&camino);
+    return destruir_nodo(nodo, arbol->intern);
+}
+
+/*ESTADÍSTICAS DE ORDEN*/
+
+const char* abb_seleccionar(const abb_t* arbol, size_t k){
+    nodo_abb_t* nodo = arbol->raiz;
+    while (nodo){
+        size_t menores = tam(nodo->izq);
+        if (k == menores) return nodo->clave;
+        if (k < menores){
+            nodo = nodo->izq;
         }else{
-            padre->izq = NULL;
+            k -= menores + 1;
+            nodo = nodo->der;
         }
     }
-    abb->cant --;
-    return destruir_nodo(nodo);
+    return NULL;
 }
 
-// Caso de borrar en el que el nodo tiene un hijo.
-void* borrar_con_un_hijo(abb_t* abb, nodo_abb_t* nodo, nodo_abb_t* padre, int comparacion){
-    if (comparacion == 0){ 
-        abb->raiz = buscar_hijo(nodo);
-    }else{
-        if (comparacion > 0){ 
-            padre->der = buscar_hijo(nodo);
+// Devuelve la cantidad de claves menores que la recibida, o menores o iguales si 'incluir' es true.
+static size_t contar_menores(const abb_t* arbol, const char* clave, bool incluir){
+    size_t cant = 0;
+    nodo_abb_t* nodo = arbol->raiz;
+    while (nodo){
+        int comparacion = comparar_claves(arbol->comparar, nodo->clave, clave);
+        if (comparacion < 0 || (comparacion == 0 && incluir)){
+            cant += tam(nodo->izq) + 1;
+            nodo = nodo->der;
+        }else if (comparacion == 0){
+            return cant + tam(nodo->izq);
         }else{
-            padre->izq = buscar_hijo(nodo);
+            nodo = nodo->izq;
         }
     }
-    abb->cant --;
-    return destruir_nodo(nodo);
+    return cant;
 }
 
-// Caso de borrar en el que el nodo tiene dos hijos.
-void* borrar_con_dos_hijos(abb_t* abb, nodo_abb_t* nodo, nodo_abb_t* padre){
-    void* dato_anterior = nodo->dato;
-    nodo_abb_t* reemplazante = buscar_reemplazante(nodo);
-    char* clave_reemplazante = strdup(reemplazante->clave);
-    void* dato_aux = abb_borrar(abb, reemplazante->clave);
-    free(nodo->clave);
-    nodo->clave = clave_reemplazante;
-    nodo->dato = dato_aux;
-    return dato_anterior;
+size_t abb_rango(const abb_t* arbol, const char* clave){
+    return contar_menores(arbol, clave, false);
 }
 
-void *abb_borrar(abb_t *arbol, const char *clave){
-    nodo_abb_t* nodo = buscar_nodo(arbol->comparar, arbol->raiz, clave);
-    if (!nodo) return NULL;
+size_t abb_contar_entre(const abb_t* arbol, const char* inicio, const char* fin){
+    size_t hasta_fin = fin ? contar_menores(arbol, fin, true) : arbol->cant;
+    size_t antes_de_inicio = inicio ? contar_menores(arbol, inicio, false) : 0;
+    return hasta_fin > antes_de_inicio ? hasta_fin - antes_de_inicio : 0;
+}
 
-    int cantidad_hijos = calcular_hijos(nodo);
-    nodo_abb_t* padre = buscar_padre(arbol->comparar, arbol->raiz, clave);
-    void* dato;
-    
-    if (cantidad_hijos == 2){
-        dato = borrar_con_dos_hijos(arbol, nodo, padre);
+/*CONSTRUCCIÓN A PARTIR DE CLAVES ORDENADAS*/
+
+// Enlaza los nodos del arreglo, que están en orden, como un árbol perfectamente balanceado
+// (y por lo tanto AVL) y devuelve su raíz.
+static nodo_abb_t* enlazar_balanceado(nodo_abb_t** nodos, size_t n){
+    if (n == 0) return NULL;
+    size_t medio = n / 2;
+    nodo_abb_t* raiz = nodos[medio];
+    raiz->izq = enlazar_balanceado(nodos, medio);
+    raiz->der = enlazar_balanceado(nodos + medio + 1, n - medio - 1);
+    actualizar_altura(raiz);
+    return raiz;
+}
+
+// Como enlazar_balanceado, pero con los nodos ya ordenados uno a continuación del otro
+// (los de un bloque_nodos_t), así que no hace falta armar un arreglo de punteros.
+static nodo_abb_t* enlazar_contiguos(nodo_abb_t* nodos, size_t n){
+    if (n == 0) return NULL;
+    size_t medio = n / 2;
+    nodo_abb_t* raiz = &nodos[medio];
+    raiz->izq = enlazar_contiguos(nodos, medio);
+    raiz->der = enlazar_contiguos(nodos + medio + 1, n - medio - 1);
+    actualizar_altura(raiz);
+    return raiz;
+}
+
+abb_t* abb_crear_desde_ordenado(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato, const char** claves, void** datos, size_t n){
+    for (size_t i = 1; i < n; i++){
+        if (cmp(claves[i - 1], claves[i]) >= 0) return NULL;
+    }
+    size_t largo_claves = 0;
+    for (size_t i = 0; i < n; i++) largo_claves += strlen(claves[i]) + 1;
+    if (n > (SIZE_MAX - sizeof(bloque_nodos_t) - largo_claves) / sizeof(nodo_abb_t)) return NULL;
+
+    abb_t* abb = abb_crear(cmp, destruir_dato);
+    bloque_nodos_t* bloque = malloc(sizeof(bloque_nodos_t) + n * sizeof(nodo_abb_t) + largo_claves);
+    if (!abb || !bloque){
+        if (abb) abb_destruir(abb);
+        free(bloque);
+        return NULL;
     }
-    else{
-        int comparacion = arbol->comparar(nodo->clave, padre->clave);
-        if (cantidad_hijos == 0){    
-            dato = borrar_hoja(arbol, nodo, padre, comparacion);
+
+    // Las claves se copian a continuación de los nodos, en el mismo bloque.
+    char* clave = (char*) &bloque->nodos[n];
+    for (size_t i = 0; i < n; i++){
+        nodo_abb_t* nodo = &bloque->nodos[i];
+        size_t largo = strlen(claves[i]) + 1;
+        memcpy(clave, claves[i], largo);
+        nodo->clave = clave;
+        nodo->dato = datos ? datos[i] : NULL;
+        nodo->en_bloque = true;
+        clave += largo;
+    }
+    bloque->sig = NULL;
+    abb->bloques = bloque;
+    abb->raiz = enlazar_contiguos(bloque->nodos, n);
+    abb->cant = n;
+    return abb;
+}
+
+// Guarda en el arreglo, a partir de la posición 'pos', los nodos del subárbol en orden.
+static void juntar_nodos(nodo_abb_t* nodo, nodo_abb_t** nodos, size_t* pos){
+    if (!nodo) return;
+    juntar_nodos(nodo->izq, nodos, pos);
+    nodos[(*pos)++] = nodo;
+    juntar_nodos(nodo->der, nodos, pos);
+}
+
+bool abb_unir(abb_t* destino, abb_t* origen){
+    size_t cant_destino = destino->cant, cant_origen = origen->cant;
+    nodo_abb_t** nodos = malloc((cant_destino + cant_origen + 1) * sizeof(nodo_abb_t*));
+    if (!nodos) return false;
+    size_t pos = 0;
+    juntar_nodos(destino->raiz, nodos, &pos);
+    juntar_nodos(origen->raiz, nodos, &pos);
+
+    // Se intercalan las dos secuencias ordenadas en un único arreglo, sin pedir nodos nuevos.
+    nodo_abb_t** unidos = malloc((cant_destino + cant_origen + 1) * sizeof(nodo_abb_t*));
+    if (!unidos){
+        free(nodos);
+        return false;
+    }
+    size_t i = 0, j = cant_destino, cant = 0;
+    while (i < cant_destino || j < cant_destino + cant_origen){
+        int comparacion;
+        if (i == cant_destino) comparacion = 1;
+        else if (j == cant_destino + cant_origen) comparacion = -1;
+        else comparacion = comparar_claves(destino->comparar, nodos[i]->clave, nodos[j]->clave);
+
+        if (comparacion < 0){
+            unidos[cant++] = nodos[i++];
+            continue;
         }
-        if (cantidad_hijos == 1){ // Es un if trivial para que sea más legible, sería un else.
-            dato = borrar_con_un_hijo(arbol, nodo, padre, comparacion);
+        if (comparacion == 0){
+            // La clave está en los dos: queda el nodo de destino con el dato de origen.
+            reemplazar_dato(nodos[i], destino, destruir_nodo(nodos[j++], origen->intern));
+            unidos[cant++] = nodos[i++];
+            continue;
         }
+        if (destino->filtro) bloom_agregar(destino->filtro, nodos[j]->clave);
+        unidos[cant++] = nodos[j++];
     }
-    return dato;
+    destino->raiz = enlazar_balanceado(unidos, cant);
+    destino->cant = cant;
+    free(nodos);
+    free(unidos);
+
+    // Los bloques de origen pasan a destino, que ahora tiene sus nodos.
+    bloque_nodos_t** ultimo = &destino->bloques;
+    while (*ultimo) ultimo = &(*ultimo)->sig;
+    *ultimo = origen->bloques;
+    origen->bloques = NULL;
+    origen->raiz = NULL;
+    origen->cant = 0;
+    abb_destruir(origen);
+    if (destino->filtro) rearmar_filtro_si_lleno(destino);
+    return true;
 }
 
 // Funcion auxiliar recursiva para abb_destruir(). Si la funcion de destruccion no es NULL, se usa para destruir el dato.
-void destruir_recursivo(abb_destruir_dato_t destruccion, nodo_abb_t* nodo){
+void destruir_recursivo(abb_destruir_dato_t destruccion, nodo_abb_t* nodo, const intern_t* intern){
     if(!nodo) return;
 
-    destruir_recursivo(destruccion, nodo->izq);
-    destruir_recursivo(destruccion, nodo->der);
+    destruir_recursivo(destruccion, nodo->izq, intern);
+    destruir_recursivo(destruccion, nodo->der, intern);
     
-    void* dato = destruir_nodo(nodo);
+    void* dato = destruir_nodo(nodo, intern);
     if(destruccion) destruccion(dato);
 } 
 
 void abb_destruir(abb_t* arbol){
-    destruir_recursivo(arbol->destruir, arbol->raiz);
+    destruir_recursivo(arbol->destruir, arbol->raiz, arbol->intern);
+    while (arbol->bloques){
+        bloque_nodos_t* sig = arbol->bloques->sig;
+        free(arbol->bloques);
+        arbol->bloques = sig;
+    }
+    if (arbol->filtro) bloom_destruir(arbol->filtro);
     free(arbol);
 }
 
@@ -273,77 +555,120 @@ void abb_in_order(abb_t *arbol, bool visitar(const char *, void *, void *), void
     rec_abb_in_order(arbol->raiz, visitar, extra, &ok);
 } 
 
+// La pila del iterador tiene a lo sumo un nodo por nivel, así que alcanza con un arreglo
+// de ALTURA_MAX nodos dentro del propio iterador: avanzar nunca pide memoria.
 struct abb_iter{
-    pila_t* pila;
+    nodo_abb_t* pila[ALTURA_MAX]; // Nodos que faltan visitar, con el actual en el tope.
+    size_t cant;
+    abb_comparar_clave_t comparar;
+    const char* limite; // Última clave del rango en el sentido del recorrido (NULL si no hay).
+    bool inverso;
 };
 
-// Recibe una pila y un nodo y apila a todos los hijos izquierdos incluyendo al nodo.
-void apilar_hijos_izquierdos(nodo_abb_t* nodo, pila_t* pila){
-    if (!nodo) return;
-    nodo_abb_t* actual = nodo;
-    pila_apilar(pila, actual);
-    while(actual && actual->izq){
-        pila_apilar(pila, actual->izq);
-        actual = actual->izq;
+// Baja desde el nodo apilando los nodos que quedan dentro del rango a partir de 'desde'
+// (cuando es NULL, todo el camino por los hijos izquierdos, o derechos si el recorrido es
+// inverso). El último apilado es el primero del recorrido.
+static void apilar_camino(abb_iter_t* iter, nodo_abb_t* nodo, const char* desde){
+    while (nodo){
+        bool adentro = true;
+        if (desde){
+            int comparacion = comparar_claves(iter->comparar, nodo->clave, desde);
+            adentro = iter->inverso ? comparacion <= 0 : comparacion >= 0;
+        }
+        if (adentro){
+            iter->pila[iter->cant++] = nodo;
+            nodo = iter->inverso ? nodo->der : nodo->izq;
+        }else{
+            nodo = iter->inverso ? nodo->izq : nodo->der;
+        }
     }
 }
 
-abb_iter_t *abb_iter_in_crear(const abb_t *arbol){
+// Si el nodo actual quedó fuera del rango, deja al iterador al final.
+static void verificar_limite(abb_iter_t* iter){
+    if (iter->cant == 0 || !iter->limite) return;
+    int comparacion = comparar_claves(iter->comparar, iter->pila[iter->cant - 1]->clave, iter->limite);
+    if (iter->inverso ? comparacion >= 0 : comparacion <= 0) return;
+    iter->cant = 0;
+}
+
+// Deja al iterador parado en el primer nodo del rango.
+static void iniciar_iter(abb_iter_t* iter, const abb_t* arbol, const char* desde, const char* hasta, bool inverso){
+    iter->cant = 0;
+    iter->comparar = arbol->comparar;
+    iter->inverso = inverso;
+    iter->limite = inverso ? desde : hasta;
+    apilar_camino(iter, arbol->raiz, inverso ? hasta : desde);
+    verificar_limite(iter);
+}
+
+static abb_iter_t* crear_iter_rango(const abb_t* arbol, const char* desde, const char* hasta, bool inverso){
     abb_iter_t* iter = malloc(sizeof(abb_iter_t));
     if (!iter) return NULL;
-    pila_t* pila = pila_crear();
-    if (!pila){
-        free(iter);
-        return NULL;
-    }
-    iter->pila = pila;
-    apilar_hijos_izquierdos(arbol->raiz, pila);
+    iniciar_iter(iter, arbol, desde, hasta, inverso);
     return iter;
 }
 
+abb_iter_t *abb_iter_rango_crear(const abb_t *arbol, const char *desde, const char *hasta){
+    return crear_iter_rango(arbol, desde, hasta, false);
+}
+
+abb_iter_t *abb_iter_rango_crear_inverso(const abb_t *arbol, const char *desde, const char *hasta){
+    return crear_iter_rango(arbol, desde, hasta, true);
+}
+
+abb_iter_t *abb_iter_in_crear(const abb_t *arbol){
+    return crear_iter_rango(arbol, NULL, NULL, false);
+}
+
+void abb_iter_in_reiniciar(abb_iter_t *iter, const abb_t *arbol){
+    iniciar_iter(iter, arbol, NULL, NULL, false);
+}
+
 bool abb_iter_in_avanzar(abb_iter_t *iter){
-    if (pila_esta_vacia(iter->pila)) return false;
-    nodo_abb_t* desapilado = pila_desapilar(iter->pila);
-    if (desapilado->der){
-        apilar_hijos_izquierdos(desapilado->der, iter->pila);
-    }
+    if (iter->cant == 0) return false;
+    nodo_abb_t* desapilado = iter->pila[--iter->cant];
+    apilar_camino(iter, iter->inverso ? desapilado->izq : desapilado->der, NULL);
+    verificar_limite(iter);
     return true;
 }
 
 const char *abb_iter_in_ver_actual(const abb_iter_t *iter){
-    nodo_abb_t* nodo = pila_ver_tope(iter->pila);
-    if (!nodo) return NULL;
-    return nodo->clave;
-
+    if (iter->cant == 0) return NULL;
+    return iter->pila[iter->cant - 1]->clave;
 }
 
 bool abb_iter_in_al_final(const abb_iter_t *iter){
-    return pila_esta_vacia(iter->pila);
+    return iter->cant == 0;
 }
 
 void abb_iter_in_destruir(abb_iter_t* iter){
-    pila_destruir(iter->pila);
     free(iter);
 }
 
 
-void _iterar_desde_clave(nodo_abb_t* nodo, abb_comparar_clave_t cmp, char* inicio, char* fin, bool visitar(const char *, void *, void *), void *extra, size_t* error){
+// Visita las claves del subárbol entre 'inicio' y 'fin' (NULL si el extremo está abierto),
+// comparando cada nodo a lo sumo una vez con cada extremo.
+void _iterar_desde_clave(nodo_abb_t* nodo, abb_comparar_clave_t cmp, const char* inicio, const char* fin, bool visitar(const char *, void *, void *), void *extra, size_t* error){
     if (!nodo || !*error) return;
-    if (cmp(inicio, nodo->clave) < 0){
+    int desde_inicio = inicio ? cmp(inicio, nodo->clave) : -1;
+    int hasta_fin = fin ? cmp(fin, nodo->clave) : 1;
+    if (desde_inicio < 0){
         _iterar_desde_clave(nodo->izq, cmp, inicio, fin, visitar, extra, error);
     }
-    if ((!strcmp(inicio, "\0") || (cmp(inicio, nodo->clave) <= 0)) && ((cmp(fin, nodo->clave) >= 0) || !strcmp(fin, "\0"))){
+    if (desde_inicio <= 0 && hasta_fin >= 0){
         if (*error && !visitar(nodo->clave, nodo->dato, extra)){
             *error = 0;
             return;
         }
     }
-    if (cmp(fin, nodo->clave) > 0 || !strcmp(fin, "\0")){
+    if (hasta_fin > 0){
         _iterar_desde_clave(nodo->der, cmp, inicio, fin, visitar, extra, error);
     }
 }
 
 void iterar_desde_clave(abb_t* abb, char* inicio, char* fin, bool visitar(const char *, void *, void *), void *extra){
     size_t ok = 1;
-    _iterar_desde_clave(abb->raiz, abb->comparar, inicio, fin, visitar, extra, &ok);
+    // La cadena vacía (o NULL) deja abierto ese extremo.
+    _iterar_desde_clave(abb->raiz, abb->comparar, inicio && *inicio ? inicio : NULL, fin && *fin ? fin : NULL, visitar, extra, &ok);
 }
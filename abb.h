@@ -4,6 +4,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include "intern.h"
 
 // Función que compara dos claves.
 typedef int (*abb_comparar_clave_t) (const char *, const char *);
@@ -13,6 +14,8 @@ typedef void (*abb_destruir_dato_t) (void *);
 
 // El arbol binario de búsqueda está implementado como una estructura que almacena punteros 
 // genéricos (datos) asociados a una clave de tipo char* 
+// Se mantiene balanceado (AVL), así que guardar, borrar y obtener son O(log n) sin importar
+// el orden en que se guardan las claves.
 struct abb;
 typedef struct abb abb_t;
 
@@ -22,6 +25,41 @@ typedef struct abb abb_t;
 // Postcondiciones: el abb fue creado.
 abb_t* abb_crear(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato);
 
+// Crea el abb igual que abb_crear, pero en lugar de copiar las claves las toma prestadas del
+// intern_t recibido (agregándolas si no estaban), que debe destruirse después que el abb.
+// Postcondiciones: el abb fue creado.
+abb_t* abb_crear_con_intern(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato, intern_t* intern);
+
+// Opciones de creación del abb. Los campos en 0 (o NULL) no se usan.
+typedef struct abb_opciones{
+    intern_t* intern;               // Como en abb_crear_con_intern.
+    double tasa_falsos_positivos;   // Si no es 0, tasa (entre 0 y 1) de un filtro de Bloom que descarta
+                                    // las claves ausentes sin recorrer el árbol. Sólo puede usarse si la
+                                    // función de comparación considera iguales únicamente a claves idénticas.
+}abb_opciones_t;
+
+// Crea el abb con las opciones recibidas (puede ser NULL). Devuelve NULL si no hay memoria o
+// si la tasa del filtro no es válida. Las claves borradas siguen marcadas en el filtro hasta que
+// se lo rearma, cada vez que se le agregan tantas claves como tenía el abb al armarlo.
+// Postcondiciones: el abb fue creado.
+abb_t* abb_crear_con_opciones(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato, const abb_opciones_t* opciones);
+
+// Crea un abb con las n claves recibidas, que deben estar ordenadas de menor a mayor según cmp y
+// sin repetidas, asociadas a los datos del arreglo 'datos' (o a NULL si 'datos' es NULL). El árbol
+// queda perfectamente balanceado y se arma en O(n), con todos sus nodos y claves en un solo bloque
+// de memoria que se libera al destruir el abb (los nodos de ese bloque que se borren antes no
+// devuelven su memoria). Devuelve NULL si las claves no están ordenadas o si no hay memoria.
+// Postcondiciones: el abb fue creado.
+abb_t* abb_crear_desde_ordenado(abb_comparar_clave_t cmp, abb_destruir_dato_t destruir_dato, const char** claves, void** datos, size_t n);
+
+// Precondiciones: ambos abb fueron creados, con la misma función de comparación y el mismo
+// intern_t (o ninguno).
+// Pasa todas las claves de origen a destino en O(n + m), reusando sus nodos, y destruye origen.
+// Si una clave está en los dos, queda el dato de origen y el de destino se destruye. Devuelve
+// false si no hay memoria, en cuyo caso ninguno de los dos cambia.
+// Postcondiciones: destino tiene las claves de ambos, perfectamente balanceado, y origen fue destruido.
+bool abb_unir(abb_t* destino, abb_t* origen);
+
 // Precondiciones: el abb fue creado.
 // Guarda en el abb la clave y con ella el dato asociado. Devuelve true si se pudo guardar, false en caso contrario.
 // Postcondiciones: ahora la clave pertenece al abb, además se devolvió true, o false en caso de no haberse guardado.
@@ -47,6 +85,22 @@ bool abb_pertenece(const abb_t *arbol, const char *clave);
 // Se devolvió la cantidad de elementos guardados en el abb.
 size_t abb_cantidad(abb_t *arbol);
 
+// Estadísticas de orden. Cada nodo guarda el tamaño de su subárbol, así que son O(log n).
+
+// Precondiciones: el abb fue creado.
+// Devuelve la clave que ocupa la posición k (empezando en 0) en el recorrido in order, o NULL si k >= abb_cantidad.
+// Por ejemplo, abb_seleccionar(arbol, abb_cantidad(arbol) / 2) es la mediana.
+const char* abb_seleccionar(const abb_t* arbol, size_t k);
+
+// Precondiciones: el abb fue creado.
+// Devuelve la cantidad de claves del abb menores que la recibida, que no necesita pertenecer al abb.
+// Si la clave pertenece, es su posición en el recorrido in order.
+size_t abb_rango(const abb_t* arbol, const char* clave);
+
+// Precondiciones: el abb fue creado.
+// Devuelve la cantidad de claves entre 'inicio' y 'fin' (ambas incluidas). Si alguna es NULL, ese extremo queda abierto.
+size_t abb_contar_entre(const abb_t* arbol, const char* inicio, const char* fin);
+
 // Precondiciones: el abb fue creado.
 // Destruye el abb y los datos que tenía guardados con la función de destrucción recibida en la creación
 // Postcondiciones: se destruyó el abb.
@@ -70,8 +124,21 @@ typedef struct abb_iter abb_iter_t;
 // Postcondiciones: el iterador fue creado.
 abb_iter_t *abb_iter_in_crear(const abb_t *arbol);
 
+// Precondiciones: el abb fue creado
+// Crea un iterador que recorre in order sólo las claves entre 'desde' y 'hasta' (ambas incluidas),
+// empezando por la primera clave mayor o igual que 'desde' sin recorrer las anteriores (O(log n)).
+// Si alguna es NULL, ese extremo queda abierto. Las claves no se copian: deben seguir existiendo
+// mientras exista el iterador. Se usa con las mismas primitivas que el iterador in order.
+// Postcondiciones: el iterador fue creado.
+abb_iter_t *abb_iter_rango_crear(const abb_t *arbol, const char *desde, const char *hasta);
+
+// Precondiciones: el abb fue creado
+// Como abb_iter_rango_crear, pero recorre el rango de mayor a menor, empezando por 'hasta'.
+// Postcondiciones: el iterador fue creado.
+abb_iter_t *abb_iter_rango_crear_inverso(const abb_t *arbol, const char *desde, const char *hasta);
+
 // Precondiciones: el iter fue creado.
-// Avanza en el recorrido in order un elemento. Si pudo avanzar devuelve true, si estaba al final, false.
+// Avanza en el recorrido in order un elemento, sin pedir memoria. Si pudo avanzar devuelve true, si estaba al final, false.
 // Postcondiciones: el iter avanzó y se devolvio true, o false si no pudo avanzar.
 bool abb_iter_in_avanzar(abb_iter_t *iter);
 
@@ -85,6 +152,12 @@ const char *abb_iter_in_ver_actual(const abb_iter_t *iter);
 // Se devolvió true si el iterador estaba al final, false si no.
 bool abb_iter_in_al_final(const abb_iter_t *iter);
 
+// Precondiciones: el iter fue creado y el abb fue creado.
+// Vuelve a empezar el recorrido in order, ahora sobre el abb recibido (puede ser otro), sin pedir
+// memoria. Sirve para recorrer muchos árboles con un único iterador.
+// Postcondiciones: el iterador está en la primera clave del abb, o al final si está vacío.
+void abb_iter_in_reiniciar(abb_iter_t *iter, const abb_t *arbol);
+
 // Precondiciones: el iter fue creado.
 // Se destruyó el iterador
 void abb_iter_in_destruir(abb_iter_t* iter);
@@ -93,7 +166,7 @@ void abb_iter_in_destruir(abb_iter_t* iter);
 void pruebas_abb_alumno(void);
 
 // Precondiciones: el abb fue creado.
-// Itera el abb desde una clave hasta otra, ambas recibidas por parámetro.
+// Itera el abb desde una clave hasta otra, ambas recibidas por parámetro. Si alguna es NULL o la cadena vacía, ese extremo queda abierto.
 // En cada una de las claves pertenecientes al intervalo recibido, se aplica la función visitar que indicia la condición de corte.
 // También se recibe un extra.
 // Postcondiciones: se recorrió el abb desde la clave 'inicio' hasta la clave 'fin'.
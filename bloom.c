@@ -0,0 +1,109 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bloom.h"
+#include "hash.h"
+#include "hash_interno.h"
+
+#define PALABRAS_BLOQUE 8 // Palabras de 64 bits por bloque: 512 bits, una línea de caché.
+#define BITS_BLOQUE 512
+#define TAM_LINEA_CACHE 64
+#define MAX_FUNCIONES 16
+#define MARGEN_BLOQUES 1.1 // Bits de más respecto de un filtro sin bloques.
+#define SEMILLA_BLOOM 0x5bd1e9955bd1e995ULL // Fija, para que el filtro no dependa de la ejecución.
+
+// Cada clave elige su bloque con los 32 bits altos de su hash, y los 'funciones'
+// bits que marca dentro del bloque con los bajos (por doble hashing).
+struct bloom{
+    uint64_t* bloques;
+    size_t cant_bloques;
+    size_t funciones;
+    size_t capacidad;
+    size_t cant;
+};
+
+bloom_t *bloom_crear(size_t capacidad, double tasa_falsos_positivos){
+    if (!(tasa_falsos_positivos > 0 && tasa_falsos_positivos < 1)) return NULL;
+    if (capacidad == 0) capacidad = 1;
+    bloom_t* bloom = malloc(sizeof(bloom_t));
+    if (!bloom) return NULL;
+
+    // Tamaño y cantidad de funciones óptimos de un filtro de Bloom clásico. Como
+    // las claves no se reparten parejo entre los bloques, se agrega un 10% de bits.
+    double ln2 = log(2);
+    double bits_por_clave = -log(tasa_falsos_positivos) / (ln2 * ln2);
+    double bits = ceil((double) capacidad * bits_por_clave * MARGEN_BLOQUES);
+    size_t funciones = (size_t) lround(bits_por_clave * ln2);
+    bloom->funciones = funciones < 1 ? 1 : funciones > MAX_FUNCIONES ? MAX_FUNCIONES : funciones;
+    bloom->cant_bloques = (size_t) ceil(bits / BITS_BLOQUE);
+    bloom->capacidad = capacidad;
+    bloom->cant = 0;
+
+    void* bloques = NULL;
+    size_t tam = bloom->cant_bloques * PALABRAS_BLOQUE * sizeof(uint64_t);
+    if (posix_memalign(&bloques, TAM_LINEA_CACHE, tam) != 0){
+        free(bloom);
+        return NULL;
+    }
+    bloom->bloques = bloques;
+    memset(bloom->bloques, 0, tam);
+    return bloom;
+}
+
+// Devuelve el bloque del hash y arma en 'mascara' los bits que le corresponden dentro de él.
+static uint64_t* bloque_y_mascara(const bloom_t* bloom, uint64_t hash, uint64_t mascara[PALABRAS_BLOQUE]){
+    hash = hash_mezclar_bits(hash);
+    size_t bloque = (size_t) (((hash >> 32) * (uint64_t) bloom->cant_bloques) >> 32);
+    uint32_t h1 = (uint32_t) hash;
+    uint32_t h2 = (uint32_t) (hash >> 41) | 1;
+    memset(mascara, 0, PALABRAS_BLOQUE * sizeof(uint64_t));
+    for (size_t i = 0; i < bloom->funciones; i++){
+        uint32_t bit = (h1 + (uint32_t) i * h2) % BITS_BLOQUE;
+        mascara[bit / 64] |= (uint64_t) 1 << (bit % 64);
+    }
+    return &bloom->bloques[bloque * PALABRAS_BLOQUE];
+}
+
+void bloom_agregar_hash(bloom_t *bloom, uint64_t hash){
+    uint64_t mascara[PALABRAS_BLOQUE];
+    uint64_t* bloque = bloque_y_mascara(bloom, hash, mascara);
+    for (size_t i = 0; i < PALABRAS_BLOQUE; i++) bloque[i] |= mascara[i];
+    bloom->cant ++;
+}
+
+bool bloom_contiene_hash(const bloom_t *bloom, uint64_t hash){
+    uint64_t mascara[PALABRAS_BLOQUE];
+    const uint64_t* bloque = bloque_y_mascara(bloom, hash, mascara);
+    // Se acumula sin cortar antes para que el compilador pueda vectorizar el ciclo.
+    uint64_t faltantes = 0;
+    for (size_t i = 0; i < PALABRAS_BLOQUE; i++) faltantes |= mascara[i] & ~bloque[i];
+    return faltantes == 0;
+}
+
+void bloom_agregar(bloom_t *bloom, const char *clave){
+    bloom_agregar_hash(bloom, hash_funcion_rapida(clave, strlen(clave), SEMILLA_BLOOM));
+}
+
+bool bloom_contiene(const bloom_t *bloom, const char *clave){
+    return bloom_contiene_hash(bloom, hash_funcion_rapida(clave, strlen(clave), SEMILLA_BLOOM));
+}
+
+size_t bloom_cantidad(const bloom_t *bloom){
+    return bloom->cant;
+}
+
+size_t bloom_capacidad(const bloom_t *bloom){
+    return bloom->capacidad;
+}
+
+void bloom_limpiar(bloom_t *bloom){
+    memset(bloom->bloques, 0, bloom->cant_bloques * PALABRAS_BLOQUE * sizeof(uint64_t));
+    bloom->cant = 0;
+}
+
+void bloom_destruir(bloom_t *bloom){
+    free(bloom->bloques);
+    free(bloom);
+}
@@ -0,0 +1,66 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Filtro de Bloom: conjunto aproximado de claves que responde "seguro no
+ * está" o "puede estar". Nunca da falsos negativos, y da falsos positivos
+ * con una tasa cercana a la pedida mientras no se agreguen más claves que
+ * su capacidad. No se pueden quitar claves.
+ *
+ * El filtro está dividido en bloques de 512 bits (una línea de caché): todos
+ * los bits de una clave caen en el mismo bloque, así que cada consulta lee una
+ * sola línea y se resuelve con operaciones sobre palabras de 64 bits. A cambio,
+ * con tasas muy bajas la tasa real queda algo por encima de la pedida (cerca
+ * del doble con 0.001).
+ */
+struct bloom;
+typedef struct bloom bloom_t;
+
+/* Crea un filtro para 'capacidad' claves con la tasa de falsos positivos
+ * recibida (entre 0 y 1, sin incluirlos). Devuelve NULL si la tasa no es
+ * válida o si no hay memoria.
+ */
+bloom_t *bloom_crear(size_t capacidad, double tasa_falsos_positivos);
+
+/* Agrega la clave al filtro.
+ * Pre: El filtro fue creado
+ */
+void bloom_agregar(bloom_t *bloom, const char *clave);
+
+/* Devuelve false si la clave seguro no fue agregada, y true si puede haberlo sido.
+ * Pre: El filtro fue creado
+ */
+bool bloom_contiene(const bloom_t *bloom, const char *clave);
+
+/* Variantes que reciben un hash de 64 bits ya calculado de la clave, para
+ * quien ya lo tiene (por ejemplo, un hash_t). Un mismo filtro debe usarse
+ * siempre con la misma función de hashing.
+ */
+void bloom_agregar_hash(bloom_t *bloom, uint64_t hash);
+bool bloom_contiene_hash(const bloom_t *bloom, uint64_t hash);
+
+/* Devuelve la cantidad de claves agregadas (contando repeticiones) desde la
+ * creación o la última limpieza.
+ * Pre: El filtro fue creado
+ */
+size_t bloom_cantidad(const bloom_t *bloom);
+
+/* Devuelve la cantidad de claves para la que se creó el filtro.
+ * Pre: El filtro fue creado
+ */
+size_t bloom_capacidad(const bloom_t *bloom);
+
+/* Vacía el filtro.
+ * Pre: El filtro fue creado
+ */
+void bloom_limpiar(bloom_t *bloom);
+
+/* Destruye el filtro.
+ * Pre: El filtro fue creado
+ */
+void bloom_destruir(bloom_t *bloom);
+
+#endif // BLOOM_H
@@ -0,0 +1,473 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "btree.h"
+
+#define GRADO 16 // Grado mínimo: todo nodo salvo la raíz tiene entre GRADO-1 y 2*GRADO-1 claves.
+#define MAX_CLAVES (2 * GRADO - 1)
+#define MAX_ALTURA 24 // Con GRADO 16, alcanza para más de 2^64 claves.
+
+/* Cada nodo guarda sus claves y sus datos en arreglos contiguos. Si el árbol
+ * ordena con strcmp, junto a cada clave se guardan sus primeros 8 bytes como un
+ * entero (el prefijo), que se compara en el orden de strcmp sin seguir el
+ * puntero a la clave: la búsqueda dentro de un nodo recorre sólo memoria
+ * seguida y lee alguna clave únicamente cuando dos prefijos coinciden.
+ * Las hojas, que son la gran mayoría de los nodos, son sólo un btree_nodo_t; los
+ * nodos internos son un btree_interno_t, que le agrega el arreglo de hijos.
+ */
+typedef struct btree_nodo{
+    uint64_t prefijos[MAX_CLAVES];
+    size_t cant;
+    bool hoja;
+    char* claves[MAX_CLAVES];
+    void* datos[MAX_CLAVES];
+}btree_nodo_t;
+
+typedef struct btree_interno{
+    btree_nodo_t nodo;
+    btree_nodo_t* hijos[MAX_CLAVES + 1];
+}btree_interno_t;
+
+struct btree{
+    btree_nodo_t* raiz;
+    size_t cant;
+    btree_comparar_clave_t comparar;
+    btree_destruir_dato_t destruir;
+    bool con_prefijos; // El orden es el de strcmp, así que los prefijos sirven para comparar.
+};
+
+// Devuelve los primeros 8 bytes de la clave (completados con ceros) como un
+// entero cuyo orden es el de strcmp.
+static uint64_t prefijo(const char* clave){
+    uint64_t p = 0;
+    bool terminada = false;
+    for (size_t i = 0; i < sizeof(uint64_t); i++){
+        terminada = terminada || clave[i] == '\0';
+        p = p << 8 | (terminada ? 0 : (unsigned char) clave[i]);
+    }
+    return p;
+}
+
+// Devuelve el arreglo de hijos de un nodo interno.
+static btree_nodo_t** hijos(const btree_nodo_t* nodo){
+    return ((btree_interno_t*) nodo)->hijos;
+}
+
+static btree_nodo_t* crear_nodo(bool hoja){
+    btree_nodo_t* nodo = malloc(hoja ? sizeof(btree_nodo_t) : sizeof(btree_interno_t));
+    if (!nodo) return NULL;
+    nodo->cant = 0;
+    nodo->hoja = hoja;
+    return nodo;
+}
+
+// Clave buscada, con su prefijo ya calculado.
+typedef struct buscada{
+    const char* clave;
+    uint64_t prefijo;
+}buscada_t;
+
+static buscada_t buscada(const char* clave){
+    buscada_t b = {clave, prefijo(clave)};
+    return b;
+}
+
+// Devuelve la posición de la primera clave del nodo que no es menor que la buscada
+// (nodo->cant si son todas menores).
+static size_t buscar_en_nodo(const btree_t* arbol, const btree_nodo_t* nodo, const buscada_t* b){
+    if (!arbol->con_prefijos){
+        size_t base = 0, n = nodo->cant;
+        while (n > 0){
+            size_t mitad = n / 2;
+            if (arbol->comparar(nodo->claves[base + mitad], b->clave) < 0){
+                base += mitad + 1;
+                n -= mitad + 1;
+            }else{
+                n = mitad;
+            }
+        }
+        return base;
+    }
+
+    // Cuenta los prefijos menores que el buscado. El ciclo no tiene saltos que
+    // dependan de los datos, así que el compilador puede vectorizarlo.
+    size_t pos = 0;
+    for (size_t i = 0; i < nodo->cant; i++) pos += nodo->prefijos[i] < b->prefijo;
+
+    // Las claves con el mismo prefijo están juntas; entre ellas decide la comparación.
+    while (pos < nodo->cant && nodo->prefijos[pos] == b->prefijo && arbol->comparar(nodo->claves[pos], b->clave) < 0) pos ++;
+    return pos;
+}
+
+// Devuelve true si la clave buscada está en la posición 'pos' del nodo.
+static bool esta_en(const btree_t* arbol, const btree_nodo_t* nodo, size_t pos, const buscada_t* b){
+    if (pos >= nodo->cant) return false;
+    if (arbol->con_prefijos && nodo->prefijos[pos] != b->prefijo) return false;
+    return arbol->comparar(nodo->claves[pos], b->clave) == 0;
+}
+
+// Copia 'n' entradas (prefijo, clave y dato) desde la posición 'desde' del nodo
+// 'origen' a la posición 'hasta' del nodo 'destino'. Pueden ser el mismo nodo.
+static void mover_entradas(btree_nodo_t* destino, size_t hasta, const btree_nodo_t* origen, size_t desde, size_t n){
+    memmove(&destino->prefijos[hasta], &origen->prefijos[desde], n * sizeof(uint64_t));
+    memmove(&destino->claves[hasta], &origen->claves[desde], n * sizeof(char*));
+    memmove(&destino->datos[hasta], &origen->datos[desde], n * sizeof(void*));
+}
+
+btree_t* btree_crear(btree_comparar_clave_t cmp, btree_destruir_dato_t destruir_dato){
+    btree_t* arbol = malloc(sizeof(btree_t));
+    if (!arbol) return NULL;
+    arbol->raiz = NULL;
+    arbol->cant = 0;
+    arbol->comparar = cmp;
+    arbol->destruir = destruir_dato;
+    arbol->con_prefijos = cmp == strcmp;
+    return arbol;
+}
+
+/*********************** Búsqueda ***********************/
+
+// Devuelve el nodo que tiene la clave y guarda en 'pos' su posición, o NULL si no está.
+static btree_nodo_t* buscar_nodo(const btree_t* arbol, const char* clave, size_t* pos){
+    buscada_t b = buscada(clave);
+    btree_nodo_t* nodo = arbol->raiz;
+    while (nodo){
+        *pos = buscar_en_nodo(arbol, nodo, &b);
+        if (esta_en(arbol, nodo, *pos, &b)) return nodo;
+        nodo = nodo->hoja ? NULL : hijos(nodo)[*pos];
+    }
+    return NULL;
+}
+
+void *btree_obtener(const btree_t *arbol, const char *clave){
+    size_t pos;
+    btree_nodo_t* nodo = buscar_nodo(arbol, clave, &pos);
+    return nodo ? nodo->datos[pos] : NULL;
+}
+
+bool btree_pertenece(const btree_t *arbol, const char *clave){
+    size_t pos;
+    return buscar_nodo(arbol, clave, &pos) != NULL;
+}
+
+size_t btree_cantidad(const btree_t *arbol){
+    return arbol->cant;
+}
+
+/*********************** Inserción ***********************/
+
+// Corre una posición a la derecha las claves (y los hijos a su derecha) desde 'pos'.
+static void abrir_lugar(btree_nodo_t* nodo, size_t pos){
+    size_t mover = nodo->cant - pos;
+    mover_entradas(nodo, pos + 1, nodo, pos, mover);
+    if (!nodo->hoja) memmove(&hijos(nodo)[pos + 2], &hijos(nodo)[pos + 1], mover * sizeof(btree_nodo_t*));
+}
+
+// Corre una posición a la izquierda las claves (y los hijos a su derecha) después de 'pos'.
+static void cerrar_lugar(btree_nodo_t* nodo, size_t pos){
+    size_t mover = nodo->cant - pos - 1;
+    mover_entradas(nodo, pos, nodo, pos + 1, mover);
+    if (!nodo->hoja) memmove(&hijos(nodo)[pos + 1], &hijos(nodo)[pos + 2], mover * sizeof(btree_nodo_t*));
+    nodo->cant --;
+}
+
+// Parte el hijo 'pos' del padre, que está lleno, en dos nodos de GRADO-1 claves
+// y sube su clave del medio al padre, que no está lleno. Devuelve false si no hay memoria.
+static bool partir_hijo(btree_nodo_t* padre, size_t pos){
+    btree_nodo_t* hijo = hijos(padre)[pos];
+    btree_nodo_t* nuevo = crear_nodo(hijo->hoja);
+    if (!nuevo) return false;
+    nuevo->cant = GRADO - 1;
+    mover_entradas(nuevo, 0, hijo, GRADO, GRADO - 1);
+    if (!hijo->hoja) memcpy(hijos(nuevo), &hijos(hijo)[GRADO], GRADO * sizeof(btree_nodo_t*));
+    hijo->cant = GRADO - 1;
+
+    abrir_lugar(padre, pos);
+    mover_entradas(padre, pos, hijo, GRADO - 1, 1);
+    hijos(padre)[pos + 1] = nuevo;
+    padre->cant ++;
+    return true;
+}
+
+// Reemplaza el dato de la posición 'pos' del nodo, destruyendo el anterior.
+static void reemplazar_dato(btree_t* arbol, btree_nodo_t* nodo, size_t pos, void* dato){
+    if (arbol->destruir) arbol->destruir(nodo->datos[pos]);
+    nodo->datos[pos] = dato;
+}
+
+bool btree_guardar(btree_t *arbol, const char *clave, void *dato){
+    if (!arbol->raiz && !(arbol->raiz = crear_nodo(true))) return false;
+    if (arbol->raiz->cant == MAX_CLAVES){
+        btree_nodo_t* raiz = crear_nodo(false);
+        if (!raiz) return false;
+        hijos(raiz)[0] = arbol->raiz;
+        if (!partir_hijo(raiz, 0)){
+            free(raiz);
+            return false;
+        }
+        arbol->raiz = raiz;
+    }
+
+    // Se baja una sola vez, partiendo antes de entrar a cada hijo lleno para que
+    // siempre haya lugar donde subir una clave. Si falta memoria a mitad de camino
+    // las particiones ya hechas dejan el árbol válido.
+    buscada_t b = buscada(clave);
+    btree_nodo_t* nodo = arbol->raiz;
+    while (true){
+        size_t pos = buscar_en_nodo(arbol, nodo, &b);
+        if (esta_en(arbol, nodo, pos, &b)){
+            reemplazar_dato(arbol, nodo, pos, dato);
+            return true;
+        }
+        if (nodo->hoja){
+            char* copia = strdup(clave);
+            if (!copia) return false;
+            abrir_lugar(nodo, pos);
+            nodo->prefijos[pos] = b.prefijo;
+            nodo->claves[pos] = copia;
+            nodo->datos[pos] = dato;
+            nodo->cant ++;
+            arbol->cant ++;
+            return true;
+        }
+        if (hijos(nodo)[pos]->cant == MAX_CLAVES){
+            if (!partir_hijo(nodo, pos)) return false;
+            int comparacion = arbol->comparar(clave, nodo->claves[pos]);
+            if (comparacion == 0){
+                reemplazar_dato(arbol, nodo, pos, dato);
+                return true;
+            }
+            if (comparacion > 0) pos ++;
+        }
+        nodo = hijos(nodo)[pos];
+    }
+}
+
+/*********************** Borrado ***********************/
+
+// Une el hijo 'pos + 1' del padre al hijo 'pos', con la clave 'pos' del padre en
+// el medio. Ambos hijos tienen GRADO-1 claves.
+static void unir_hijos(btree_nodo_t* padre, size_t pos){
+    btree_nodo_t* izq = hijos(padre)[pos];
+    btree_nodo_t* der = hijos(padre)[pos + 1];
+    mover_entradas(izq, izq->cant, padre, pos, 1);
+    mover_entradas(izq, izq->cant + 1, der, 0, der->cant);
+    if (!izq->hoja) memcpy(&hijos(izq)[izq->cant + 1], hijos(der), (der->cant + 1) * sizeof(btree_nodo_t*));
+    izq->cant += der->cant + 1;
+    cerrar_lugar(padre, pos);
+    free(der);
+}
+
+// Pasa la última clave del hijo 'pos - 1' al padre y la clave del padre al
+// principio del hijo 'pos'.
+static void rotar_desde_izquierda(btree_nodo_t* padre, size_t pos){
+    btree_nodo_t* hijo = hijos(padre)[pos];
+    btree_nodo_t* hermano = hijos(padre)[pos - 1];
+    mover_entradas(hijo, 1, hijo, 0, hijo->cant);
+    if (!hijo->hoja) memmove(&hijos(hijo)[1], hijos(hijo), (hijo->cant + 1) * sizeof(btree_nodo_t*));
+    mover_entradas(hijo, 0, padre, pos - 1, 1);
+    if (!hijo->hoja) hijos(hijo)[0] = hijos(hermano)[hermano->cant];
+    hijo->cant ++;
+    mover_entradas(padre, pos - 1, hermano, hermano->cant - 1, 1);
+    hermano->cant --;
+}
+
+// Pasa la primera clave del hijo 'pos + 1' al padre y la clave del padre al
+// final del hijo 'pos'.
+static void rotar_desde_derecha(btree_nodo_t* padre, size_t pos){
+    btree_nodo_t* hijo = hijos(padre)[pos];
+    btree_nodo_t* hermano = hijos(padre)[pos + 1];
+    mover_entradas(hijo, hijo->cant, padre, pos, 1);
+    if (!hijo->hoja) hijos(hijo)[hijo->cant + 1] = hijos(hermano)[0];
+    hijo->cant ++;
+    mover_entradas(padre, pos, hermano, 0, 1);
+    mover_entradas(hermano, 0, hermano, 1, hermano->cant - 1);
+    if (!hermano->hoja) memmove(hijos(hermano), &hijos(hermano)[1], hermano->cant * sizeof(btree_nodo_t*));
+    hermano->cant --;
+}
+
+// Se asegura de que el hijo 'pos' tenga al menos GRADO claves antes de bajar a
+// él, pidiéndole una a un hermano o uniéndolo con uno. Devuelve la posición del
+// hijo al que hay que bajar, que cambia si se lo unió con su hermano izquierdo.
+static size_t preparar_hijo(btree_nodo_t* padre, size_t pos){
+    if (hijos(padre)[pos]->cant >= GRADO) return pos;
+    if (pos > 0 && hijos(padre)[pos - 1]->cant >= GRADO){
+        rotar_desde_izquierda(padre, pos);
+    }else if (pos < padre->cant && hijos(padre)[pos + 1]->cant >= GRADO){
+        rotar_desde_derecha(padre, pos);
+    }else if (pos < padre->cant){
+        unir_hijos(padre, pos);
+    }else{
+        unir_hijos(padre, --pos);
+    }
+    return pos;
+}
+
+// Quita del subárbol la clave y guarda en 'clave_quitada' y 'dato' la clave y el
+// dato que tenía, sin liberarlos. El nodo tiene al menos GRADO claves (salvo que
+// sea la raíz), así que siempre puede perder una. Devuelve false si la clave no estaba.
+static bool quitar(const btree_t* arbol, btree_nodo_t* nodo, const char* clave, char** clave_quitada, void** dato){
+    buscada_t b = buscada(clave);
+    while (true){
+        size_t pos = buscar_en_nodo(arbol, nodo, &b);
+        bool encontrada = esta_en(arbol, nodo, pos, &b);
+        if (nodo->hoja){
+            if (!encontrada) return false;
+            *clave_quitada = nodo->claves[pos];
+            *dato = nodo->datos[pos];
+            cerrar_lugar(nodo, pos);
+            return true;
+        }
+        if (!encontrada){
+            pos = preparar_hijo(nodo, pos);
+            nodo = hijos(nodo)[pos];
+            continue;
+        }
+
+        // La clave está en un nodo interno: se la reemplaza por su predecesora o
+        // su sucesora, si el hijo correspondiente puede perder una clave, o se
+        // unen los dos hijos y se la sigue buscando en el nodo unido.
+        *clave_quitada = nodo->claves[pos];
+        *dato = nodo->datos[pos];
+        btree_nodo_t* izq = hijos(nodo)[pos];
+        btree_nodo_t* der = hijos(nodo)[pos + 1];
+        if (izq->cant >= GRADO || der->cant >= GRADO){
+            btree_nodo_t* extremo = izq->cant >= GRADO ? izq : der;
+            btree_nodo_t* hoja = extremo;
+            while (!hoja->hoja) hoja = hijos(hoja)[extremo == izq ? hoja->cant : 0];
+            const char* vecina = hoja->claves[extremo == izq ? hoja->cant - 1 : 0];
+            quitar(arbol, extremo, vecina, &nodo->claves[pos], &nodo->datos[pos]);
+            nodo->prefijos[pos] = prefijo(nodo->claves[pos]);
+            return true;
+        }
+        unir_hijos(nodo, pos);
+        nodo = izq;
+    }
+}
+
+void *btree_borrar(btree_t *arbol, const char *clave){
+    if (!arbol->raiz) return NULL;
+    char* clave_quitada;
+    void* dato;
+    bool encontrada = quitar(arbol, arbol->raiz, clave, &clave_quitada, &dato);
+
+    // Si la raíz quedó vacía, el árbol pierde un nivel.
+    btree_nodo_t* raiz = arbol->raiz;
+    if (raiz->cant == 0){
+        arbol->raiz = raiz->hoja ? NULL : hijos(raiz)[0];
+        free(raiz);
+    }
+    if (!encontrada) return NULL;
+    free(clave_quitada);
+    arbol->cant --;
+    return dato;
+}
+
+/*********************** Destrucción ***********************/
+
+static void destruir_nodo(btree_t* arbol, btree_nodo_t* nodo){
+    for (size_t i = 0; i < nodo->cant; i++){
+        if (arbol->destruir) arbol->destruir(nodo->datos[i]);
+        free(nodo->claves[i]);
+    }
+    if (!nodo->hoja){
+        for (size_t i = 0; i <= nodo->cant; i++) destruir_nodo(arbol, hijos(nodo)[i]);
+    }
+    free(nodo);
+}
+
+void btree_destruir(btree_t *arbol){
+    if (arbol->raiz) destruir_nodo(arbol, arbol->raiz);
+    free(arbol);
+}
+
+/*********************** Iterador interno ***********************/
+
+// Visita en orden las claves del subárbol entre 'inicio' y 'fin' (NULL si el
+// extremo está abierto). Devuelve false si hay que cortar la iteración.
+static bool iterar_nodo(const btree_t* arbol, const btree_nodo_t* nodo, const buscada_t* inicio, const char* fin, bool visitar(const char *, void *, void *), void* extra){
+    size_t pos = inicio ? buscar_en_nodo(arbol, nodo, inicio) : 0;
+    for (; pos <= nodo->cant; pos++){
+        if (!nodo->hoja && !iterar_nodo(arbol, hijos(nodo)[pos], inicio, fin, visitar, extra)) return false;
+        if (pos == nodo->cant) break;
+        if (fin && arbol->comparar(nodo->claves[pos], fin) > 0) return false;
+        if (!visitar(nodo->claves[pos], nodo->datos[pos], extra)) return false;
+        // Las claves que siguen son todas mayores que 'inicio'.
+        inicio = NULL;
+    }
+    return true;
+}
+
+void btree_in_order(btree_t *arbol, bool visitar(const char *, void *, void *), void *extra){
+    if (arbol->raiz) iterar_nodo(arbol, arbol->raiz, NULL, NULL, visitar, extra);
+}
+
+void btree_iterar_desde_clave(btree_t *arbol, const char *inicio, const char *fin, bool visitar(const char *, void *, void *), void *extra){
+    if (inicio && !*inicio) inicio = NULL;
+    if (fin && !*fin) fin = NULL;
+    buscada_t desde = buscada(inicio ? inicio : "");
+    if (arbol->raiz) iterar_nodo(arbol, arbol->raiz, inicio ? &desde : NULL, fin, visitar, extra);
+}
+
+/*********************** Iterador externo ***********************/
+
+// Camino desde la raíz hasta la clave actual: en cada nivel, el nodo y la
+// posición de la próxima clave a visitar en él.
+typedef struct nivel{
+    const btree_nodo_t* nodo;
+    size_t pos;
+}nivel_t;
+
+struct btree_iter{
+    nivel_t camino[MAX_ALTURA];
+    size_t altura;
+};
+
+// Baja por los primeros hijos desde el nodo hasta una hoja, apilando el camino.
+static void bajar_a_la_izquierda(btree_iter_t* iter, const btree_nodo_t* nodo){
+    while (true){
+        iter->camino[iter->altura].nodo = nodo;
+        iter->camino[iter->altura].pos = 0;
+        iter->altura ++;
+        if (nodo->hoja) return;
+        nodo = hijos(nodo)[0];
+    }
+}
+
+btree_iter_t *btree_iter_in_crear(const btree_t *arbol){
+    btree_iter_t* iter = malloc(sizeof(btree_iter_t));
+    if (!iter) return NULL;
+    iter->altura = 0;
+    if (arbol->raiz && arbol->raiz->cant > 0) bajar_a_la_izquierda(iter, arbol->raiz);
+    return iter;
+}
+
+bool btree_iter_in_avanzar(btree_iter_t *iter){
+    if (btree_iter_in_al_final(iter)) return false;
+    nivel_t* actual = &iter->camino[iter->altura - 1];
+    actual->pos ++;
+    if (!actual->nodo->hoja){
+        bajar_a_la_izquierda(iter, hijos(actual->nodo)[actual->pos]);
+    }else{
+        while (iter->altura > 0 && iter->camino[iter->altura - 1].pos >= iter->camino[iter->altura - 1].nodo->cant){
+            iter->altura --;
+        }
+    }
+    return true;
+}
+
+const char *btree_iter_in_ver_actual(const btree_iter_t *iter){
+    if (btree_iter_in_al_final(iter)) return NULL;
+    const nivel_t* actual = &iter->camino[iter->altura - 1];
+    return actual->nodo->claves[actual->pos];
+}
+
+bool btree_iter_in_al_final(const btree_iter_t *iter){
+    return iter->altura == 0;
+}
+
+void btree_iter_in_destruir(btree_iter_t* iter){
+    free(iter);
+}
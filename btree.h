@@ -0,0 +1,92 @@
+#ifndef _BTREE_H
+#define _BTREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Función que compara dos claves.
+typedef int (*btree_comparar_clave_t) (const char *, const char *);
+
+// Función de destrucción de un dato de tipo void*.
+typedef void (*btree_destruir_dato_t) (void *);
+
+// Árbol B: diccionario ordenado con las mismas primitivas que el abb, pero con nodos
+// anchos (de hasta 31 claves) que guardan sus claves y sus datos en arreglos contiguos.
+// Cada búsqueda visita un nodo por nivel y el árbol tiene muy pocos niveles (4 con
+// un millón de claves), así que hay muchos menos fallos de caché que en el abb. Si la función
+// de comparación es strcmp, además se comparan los primeros 8 bytes de cada clave sin salir del nodo.
+struct btree;
+typedef struct btree btree_t;
+
+// Primitivas del árbol B
+
+// Recibe la función de comparacion y destrucción y crea el árbol.
+// Postcondiciones: el árbol fue creado.
+btree_t* btree_crear(btree_comparar_clave_t cmp, btree_destruir_dato_t destruir_dato);
+
+// Precondiciones: el árbol fue creado.
+// Guarda en el árbol la clave y con ella el dato asociado. Devuelve true si se pudo guardar, false en caso contrario.
+// Sólo pide memoria si la clave es nueva.
+// Postcondiciones: ahora la clave pertenece al árbol, además se devolvió true, o false en caso de no haberse guardado.
+bool btree_guardar(btree_t *arbol, const char *clave, void *dato);
+
+// Precondiciones: el árbol fue creado.
+// Borra el dato asociado a la clave recibida por parámetro y lo devuelve. En caso de no encontrar la clave, devuelve NULL
+// Postcondiciones: se devolvió el dato o NULL si no estaba la clave.
+void *btree_borrar(btree_t *arbol, const char *clave);
+
+// Precondiciones: el árbol fue creado.
+// Devuelve el dato asociado a la clave recibida por parámetro. En caso de no encontrar la clave, devuelve NULL
+// Postcondiciones: se devolvió el dato o NULL si no estaba la clave.
+void *btree_obtener(const btree_t *arbol, const char *clave);
+
+// Precondiciones: el árbol fue creado.
+// Devuelve true en caso de que la clave recibida por parámetro se encontrara en el árbol, false en caso contrario
+bool btree_pertenece(const btree_t *arbol, const char *clave);
+
+// Precondiciones: el árbol fue creado.
+// Devuelve la cantidad de elementos que el árbol tiene guardados.
+size_t btree_cantidad(const btree_t *arbol);
+
+// Precondiciones: el árbol fue creado.
+// Destruye el árbol y los datos que tenía guardados con la función de destrucción recibida en la creación
+// Postcondiciones: se destruyó el árbol.
+void btree_destruir(btree_t *arbol);
+
+// Iterador interno
+// Precondiciones: el árbol fue creado.
+// Recorre en orden el árbol y le aplica a cada elemento la función visitar.
+// La iteración se detiene cuando esta función devuelve false. Además recibe un parámetro extra.
+void btree_in_order(btree_t *arbol, bool visitar(const char *, void *, void *), void *extra);
+
+// Precondiciones: el árbol fue creado.
+// Como btree_in_order, pero sólo con las claves entre 'inicio' y 'fin' (ambas incluidas).
+// Si inicio o fin son NULL (o la cadena vacía, como en el abb), ese extremo queda abierto.
+void btree_iterar_desde_clave(btree_t *arbol, const char *inicio, const char *fin, bool visitar(const char *, void *, void *), void *extra);
+
+// Iterador externo
+typedef struct btree_iter btree_iter_t;
+
+// Primitivas iterador externo
+
+// Precondiciones: el árbol fue creado
+// Crea un iterador que recorre las claves en orden.
+btree_iter_t *btree_iter_in_crear(const btree_t *arbol);
+
+// Precondiciones: el iter fue creado.
+// Avanza un elemento. Si pudo avanzar devuelve true, si estaba al final, false.
+bool btree_iter_in_avanzar(btree_iter_t *iter);
+
+// Precondiciones: el iter fue creado.
+// Devuelve la clave del elemento en donde el iterador estaba parado, NULL si estaba al final.
+const char *btree_iter_in_ver_actual(const btree_iter_t *iter);
+
+// Precondiciones: el iter fue creado.
+// Devuelve true si el iterador está al final (una posición después del último elemento), false en caso contrario.
+bool btree_iter_in_al_final(const btree_iter_t *iter);
+
+// Precondiciones: el iter fue creado.
+// Se destruyó el iterador
+void btree_iter_in_destruir(btree_iter_t* iter);
+
+#endif // _BTREE_H
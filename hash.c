@@ -1,325 +1,695 @@
 #define  _POSIX_C_SOURCE 200809L
+#include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#include "bloom.h"
 #include "hash.h"
-#include "lista.h"
+#include "hash_interno.h"
 
-#define TAM_INICIAL 13
-#define FACTOR_REDIMENSION 2
-#define FACTOR_CARGA_MAX 1.5
+#define TAM_INICIAL 16 // Debe ser potencia de dos.
+#define FACTOR_REDIMENSION 2 // Valores por omisión de la política de redimensión.
+#define FACTOR_CARGA_MAX 0.85
 #define FACTOR_CARGA_MIN 0.2
-
-
-
-typedef struct hash_campo{ 
-    char* clave;
+#define FACTOR_CARGA_TOPE 0.95 // Factor de carga máximo admitido en una política.
+#define PASO_MIGRACION 8 // Posiciones de la tabla anterior que migra cada operación de escritura.
+#define TAM_LOTE 16 // Claves cuyas posiciones se piden juntas en las operaciones por lotes.
+#define HASH_P0 0xa0761d6478bd642fULL // Constantes de mezcla de hash_funcion_rapida.
+#define HASH_P1 0xe7037ed1a0b428dbULL
+#define HASH_P2 0x8ebc6af09c88c6e3ULL
+
+
+#if defined(__GNUC__)
+#define PREFETCH(direccion) __builtin_prefetch(direccion)
+#else
+#define PREFETCH(direccion) ((void) (direccion))
+#endif
+
+// Con HASH_CONTADORES definido, cada operación suma a los contadores del hash,
+// incluso las consultas (que reciben el hash como const, pero el hash siempre se
+// creó con malloc, así que se lo puede modificar). Sin él no se cuenta nada.
+#ifdef HASH_CONTADORES
+#define CONTAR(hash, contador) (((hash_t*) (hash))->contadores.contador ++)
+#define SONDEOS(hash) (&((hash_t*) (hash))->contadores.sondeos)
+#else
+#define CONTAR(hash, contador) ((void) 0)
+#define SONDEOS(hash) NULL
+#endif
+
+// La tabla (HASH_TABLA_DEFINIR, en hash_interno.h) usa direccionamiento abierto
+// con Robin Hood: los campos se guardan en línea en un único arreglo y 'dist' es
+// la distancia desde la posición ideal de la clave más uno (0 indica una posición vacía).
+// En la tabla anterior de una migración, un campo con dist distinto de 0 y largo
+// HASH_LARGO_BORRADO ya fue migrado o borrado: conserva su dist para no cortar las búsquedas.
+// Cada campo guarda el hash completo y el largo de su clave: se comparan antes que
+// la clave en las búsquedas y se reutilizan al migrar a otra tabla.
+// Las claves de hasta HASH_CLAVE_CORTA_MAX caracteres se guardan dentro del campo; las
+// más largas se copian a memoria dinámica, o se toman prestadas del intern_t del
+// hash si tiene uno.
+typedef struct hash_campo{
+    uint64_t hash;
+    union{
+        char* larga;
+        char corta[HASH_CLAVE_CORTA_MAX + 1];
+    }clave;
     void* dato_hash;
-    
+    uint32_t largo;
+    uint32_t dist;
 }hash_campo_t;
 
-
-
-hash_campo_t* crear_campo(const char* clave, void* dato_hash, hash_destruir_dato_t destruir_dato){
-    hash_campo_t* campo = malloc(sizeof(hash_campo_t));
-    if (!campo) return NULL;
-    campo->clave = strdup(clave);
-    if (!campo->clave){
-        free(campo);
-        return NULL;
-    }
-    campo->dato_hash = dato_hash;
-    return campo;
-}
-
-void destruir_campo(hash_campo_t* campo, hash_destruir_dato_t destruir){
-    if (campo->clave){
-        if(destruir != NULL){ 
-            destruir(campo->dato_hash);
-        }    
-        free(campo->clave);
-        free(campo);
-    }
-}
+HASH_TABLA_DEFINIR(hash_campo_t)
 
 /********************************************************/
 
+// Al redimensionar, la tabla actual pasa a ser 'anterior' y sus campos se mueven
+// de a poco a la nueva tabla en cada guardar o borrar. Mientras dure la migración
+// las búsquedas consultan ambas tablas.
 struct hash{
-    lista_t** tabla;
+    hash_campo_t* tabla;
     size_t cant;
     size_t tam;
+    hash_campo_t* anterior;
+    size_t tam_anterior;
+    size_t cant_anterior;
+    size_t migrados;
     hash_destruir_dato_t destruccion;
+    hash_funcion_t funcion;
+    uint64_t semilla;
+    hash_politica_t politica;
+    size_t tam_minimo;
+    size_t redimensiones;
+    double segundos_redimension;
+    intern_t* intern;
+    bloom_t* filtro;
+    double tasa_filtro;
+#ifdef HASH_CONTADORES
+    hash_contadores_t contadores;
+#endif
 };
 
 
 // Función djb2 por Dan Bernstein.
 // http://www.cse.yorku.ca/~oz/hash.html
-size_t funcion_hashing(const char *str){
-    size_t hash = 5381;
-    int c;
-    while ((c = *str++)){
-        hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+uint64_t hash_funcion_djb2(const char *clave, size_t largo, uint64_t semilla){
+    uint64_t hash = 5381 ^ semilla;
+    for (size_t i = 0; i < largo; i++){
+        hash = ((hash << 5) + hash) + (unsigned char) clave[i]; /* hash * 33 + c */
     }
-    return hash;
+    return hash_mezclar_bits(hash);
 }
 
-// Crea un hash auxiliar con un nuevo tamaño de tabla y lo devuelve.
-hash_t* crear_hash_auxiliar(hash_t* hash, size_t nuevo_tam){
-    hash_t* aux = malloc(sizeof(hash_t));
-    if(!aux) return NULL;
-    lista_t** tabla = calloc(sizeof(lista_t*), nuevo_tam);
-    if (!tabla){
-        free(aux);
-        return NULL;
+// Multiplica a y b en 128 bits y devuelve el xor de la mitad alta y la baja.
+static uint64_t multiplicar_plegado(uint64_t a, uint64_t b){
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t) a * b;
+    return (uint64_t) r ^ (uint64_t) (r >> 64);
+#else
+    uint64_t a_bajo = (uint32_t) a, a_alto = a >> 32;
+    uint64_t b_bajo = (uint32_t) b, b_alto = b >> 32;
+    uint64_t bajo_bajo = a_bajo * b_bajo, alto_bajo = a_alto * b_bajo;
+    uint64_t bajo_alto = a_bajo * b_alto, alto_alto = a_alto * b_alto;
+    uint64_t medio = (bajo_bajo >> 32) + (uint32_t) alto_bajo + bajo_alto;
+    uint64_t alto = alto_alto + (alto_bajo >> 32) + (medio >> 32);
+    uint64_t bajo = (medio << 32) | (uint32_t) bajo_bajo;
+    return alto ^ bajo;
+#endif
+}
+
+// Leen 8 y 4 bytes de la clave sin requerir alineación.
+static uint64_t leer_64(const unsigned char* p){
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t leer_32(const unsigned char* p){
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Variante de wyhash: cada bloque de 16 bytes se mezcla con el estado mediante
+// una multiplicación plegada, y los últimos (hasta 16) bytes se leen solapados.
+uint64_t hash_funcion_rapida(const char *clave, size_t largo, uint64_t semilla){
+    const unsigned char* p = (const unsigned char*) clave;
+    uint64_t h = semilla ^ multiplicar_plegado(semilla ^ HASH_P0, HASH_P1);
+    size_t restantes = largo;
+    while (restantes > 16){
+        h = multiplicar_plegado(leer_64(p) ^ HASH_P1, leer_64(p + 8) ^ h);
+        p += 16;
+        restantes -= 16;
+    }
+    uint64_t a = 0, b = 0;
+    if (restantes > 8){
+        a = leer_64(p);
+        b = leer_64(p + restantes - 8);
+    }else if (restantes >= 4){
+        a = leer_32(p);
+        b = leer_32(p + restantes - 4);
+    }else if (restantes > 0){
+        a = ((uint64_t) p[0] << 16) | ((uint64_t) p[restantes / 2] << 8) | p[restantes - 1];
     }
-    aux->tabla = tabla;
-    aux->cant = 0;
-    aux->tam = nuevo_tam;
-    aux->destruccion = hash->destruccion;
-    return aux;
-}
-// Recibe dos hash y actualiza los datos de uno para que sean iguales a los del segundo.
-void hash_actualizar_datos(hash_t* hash, hash_t* hash_aux, size_t nuevo_tam){
-    lista_t** tabla_a_liberar = hash->tabla;
-    hash->tabla = hash_aux->tabla;
-    hash->cant = hash_aux->cant;
+    return multiplicar_plegado(HASH_P2 ^ largo, multiplicar_plegado(a ^ HASH_P1, b ^ h));
+}
+
+// Base de las semillas, elegida una sola vez por proceso (con pthread_once, porque
+// se pueden crear tablas desde varios hilos a la vez).
+static uint64_t base_semillas = 0;
+static pthread_once_t base_semillas_elegida = PTHREAD_ONCE_INIT;
+
+static void elegir_base_semillas(void){
+    uint64_t base;
+    FILE* urandom = fopen("/dev/urandom", "rb");
+    if (!urandom || fread(&base, sizeof(base), 1, urandom) != 1){
+        base = (uint64_t) time(NULL) ^ ((uint64_t) clock() << 32);
+    }
+    if (urandom) fclose(urandom);
+    base_semillas = base | 1;
+}
+
+// Devuelve el próximo valor del contador de semillas, sin repetir valores aunque
+// se lo llame desde varios hilos.
+static uint64_t siguiente_semilla(void){
+    static uint64_t contador = 0;
+#if defined(__GNUC__)
+    return __atomic_add_fetch(&contador, 1, __ATOMIC_RELAXED);
+#else
+    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_mutex_lock(&mutex);
+    uint64_t valor = ++contador;
+    pthread_mutex_unlock(&mutex);
+    return valor;
+#endif
+}
+
+uint64_t hash_semilla_aleatoria(void){
+    pthread_once(&base_semillas_elegida, elegir_base_semillas);
+    // La mezcla es biyectiva: contadores distintos dan semillas distintas.
+    uint64_t semilla = hash_mezclar_bits(base_semillas + siguiente_semilla() * 0x9e3779b97f4a7c15ULL);
+    return semilla ? semilla : HASH_P0;
+}
+
+// Devuelve el hash de la clave según la función y la semilla del hash, y guarda su largo en 'largo'.
+static uint64_t calcular_hash(const hash_t* hash, const char* clave, size_t* largo){
+    *largo = strlen(clave);
+    return hash->funcion(clave, *largo, hash->semilla);
+}
+
+// Devuelve true si el campo guarda una clave vigente.
+static bool campo_ocupado(const hash_campo_t* campo){
+    return campo->dist != 0 && campo->largo != HASH_LARGO_BORRADO;
+}
+
+// Devuelve el campo de la clave, buscándolo en la tabla actual y, si hay una
+// migración en curso, en la anterior. Devuelve NULL si la clave no está.
+static hash_campo_t* buscar_campo(const hash_t* hash, const char* clave, uint64_t h, size_t largo){
+    if (hash->filtro && !bloom_contiene_hash(hash->filtro, h)) return NULL;
+    CONTAR(hash, busquedas);
+    size_t pos = buscar_posicion(hash->tabla, hash->tam, clave, h, largo, SONDEOS(hash));
+    if (pos != hash->tam) return &hash->tabla[pos];
+    if (!hash->anterior) return NULL;
+    pos = buscar_posicion(hash->anterior, hash->tam_anterior, clave, h, largo, SONDEOS(hash));
+    if (pos != hash->tam_anterior) return &hash->anterior[pos];
+    return NULL;
+}
+
+// Mueve a la tabla actual los campos de las próximas 'cantidad' posiciones de la
+// tabla anterior. Cuando ya no quedan campos por migrar libera la tabla anterior.
+static void migrar_campos(hash_t* hash, size_t cantidad){
+    if (!hash->anterior) return;
+    for (size_t i = 0; i < cantidad && hash->cant_anterior > 0; i++){
+        hash_campo_t* campo = &hash->anterior[hash->migrados];
+        if (campo_ocupado(campo)){
+            insertar_campo(hash->tabla, hash->tam, *campo);
+            campo->largo = HASH_LARGO_BORRADO;
+            hash->cant_anterior --;
+            CONTAR(hash, migrados);
+        }
+        hash->migrados ++;
+    }
+    if (hash->cant_anterior == 0){
+        free(hash->anterior);
+        hash->anterior = NULL;
+        hash->tam_anterior = 0;
+        hash->migrados = 0;
+    }
+}
+
+// Termina de una vez la migración en curso, si la hay.
+static void terminar_migracion(hash_t* hash){
+    migrar_campos(hash, hash->tam_anterior);
+}
+
+// Agrega al filtro los hashes de las claves vigentes de la tabla.
+static void agregar_tabla_filtro(bloom_t* filtro, const hash_campo_t* tabla, size_t tam){
+    for (size_t i = 0; i < tam; i++){
+        if (campo_ocupado(&tabla[i])) bloom_agregar_hash(filtro, tabla[i].hash);
+    }
+}
+
+// Arma de nuevo el filtro sólo con las claves vigentes (sin las borradas) y con
+// lugar para el doble de las que hay. Si no hay memoria se sigue con el filtro
+// actual, que contiene a todas las claves aunque dé más falsos positivos.
+static void reconstruir_filtro(hash_t* hash){
+    size_t capacidad = 2 * hash->cant > TAM_INICIAL ? 2 * hash->cant : TAM_INICIAL;
+    bloom_t* filtro = bloom_crear(capacidad, hash->tasa_filtro);
+    if (!filtro) return;
+    agregar_tabla_filtro(filtro, hash->tabla, hash->tam);
+    if (hash->anterior) agregar_tabla_filtro(filtro, hash->anterior, hash->tam_anterior);
+    bloom_destruir(hash->filtro);
+    hash->filtro = filtro;
+}
+
+// Devuelve los segundos transcurridos desde 'inicio'.
+static double segundos_desde(const struct timespec* inicio){
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (double) (fin.tv_sec - inicio->tv_sec) + (double) (fin.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+// Función auxiliar para redimensionar el hash. Pide la nueva tabla y deja la actual
+// como tabla anterior; sus campos se migran luego de a PASO_MIGRACION posiciones.
+static bool redimensionar_hash(hash_t* hash, size_t nuevo_tam){
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    terminar_migracion(hash);
+    hash_campo_t* nueva_tabla = calloc(nuevo_tam, sizeof(hash_campo_t));
+    if (!nueva_tabla) return false;
+    if (hash->cant == 0){
+        free(hash->tabla);
+    }else{
+        hash->anterior = hash->tabla;
+        hash->tam_anterior = hash->tam;
+        hash->cant_anterior = hash->cant;
+        hash->migrados = 0;
+    }
+    hash->tabla = nueva_tabla;
     hash->tam = nuevo_tam;
-    free(tabla_a_liberar);
-    free(hash_aux);
+    hash->redimensiones ++;
+    hash->segundos_redimension += segundos_desde(&inicio);
+    return true;
 }
 
+// Completa la política recibida con los valores por omisión y la corrige para que
+// sea válida: el factor de carga máximo queda por debajo de FACTOR_CARGA_TOPE, el
+// de crecimiento es una potencia de dos, y el mínimo deja margen (histéresis)
+// para que la tabla recién agrandada no quede en condiciones de achicarse.
+hash_politica_t hash_normalizar_politica(const hash_politica_t* politica){
+    hash_politica_t res = {FACTOR_CARGA_MAX, FACTOR_CARGA_MIN, FACTOR_REDIMENSION};
+    if (politica && politica->factor_carga_max > 0) res.factor_carga_max = politica->factor_carga_max;
+    if (politica && politica->factor_carga_min > 0) res.factor_carga_min = politica->factor_carga_min;
+    if (politica && politica->factor_crecimiento > 1) res.factor_crecimiento = politica->factor_crecimiento;
+    if (res.factor_carga_max > FACTOR_CARGA_TOPE) res.factor_carga_max = FACTOR_CARGA_TOPE;
+    size_t crecimiento = 2;
+    while (crecimiento < res.factor_crecimiento) crecimiento *= 2;
+    res.factor_crecimiento = crecimiento;
+    if (res.factor_carga_min * (double) crecimiento >= res.factor_carga_max){
+        res.factor_carga_min = res.factor_carga_max / (double) (2 * crecimiento);
+    }
+    return res;
+}
 
-// Función auxiliar para redimensionar el hash.
-bool redimensionar_hash(hash_t* hash, size_t nuevo_tam){
-    hash_t* hash_aux = crear_hash_auxiliar(hash, nuevo_tam);
+// Devuelve el menor tamaño de tabla (potencia de dos, no menor a TAM_INICIAL) en
+// el que entran 'cantidad' claves sin superar el factor de carga 'factor'.
+size_t hash_tam_para_cantidad(size_t cantidad, double factor){
+    size_t tam = TAM_INICIAL;
+    while ((double) cantidad > (double) tam * factor) tam *= 2;
+    return tam;
+}
 
+// Pasa todos los campos a una tabla nueva de nuevo_tam de una sola vez, terminando
+// antes la migración en curso si la hay.
+static bool rehacer_tabla(hash_t* hash, size_t nuevo_tam){
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    terminar_migracion(hash);
+    if (nuevo_tam == hash->tam) return true;
+    hash_campo_t* nueva_tabla = calloc(nuevo_tam, sizeof(hash_campo_t));
+    if (!nueva_tabla) return false;
     for (size_t i = 0; i < hash->tam; i++){
-        if(!hash->tabla[i]) continue;
-        lista_iter_t* iter = lista_iter_crear(hash->tabla[i]);
-        if (!iter) return false;
-        while(!lista_iter_al_final(iter)){
-            hash_campo_t* actual = (hash_campo_t*) lista_iter_ver_actual(iter);
-            const char* clave = actual->clave;
-            hash_guardar(hash_aux, clave, actual->dato_hash);
-            free(actual->clave);
-            free(actual);
-            lista_iter_avanzar(iter);
-        }
-        lista_iter_destruir(iter);  
-        lista_destruir(hash->tabla[i], NULL);
+        if (campo_ocupado(&hash->tabla[i])) insertar_campo(nueva_tabla, nuevo_tam, hash->tabla[i]);
     }
-    hash_actualizar_datos(hash, hash_aux, nuevo_tam);
+    free(hash->tabla);
+    hash->tabla = nueva_tabla;
+    hash->tam = nuevo_tam;
+    hash->redimensiones ++;
+    hash->segundos_redimension += segundos_desde(&inicio);
     return true;
 }
 
-hash_t *hash_crear(hash_destruir_dato_t destruir_dato){
+hash_t *hash_crear_con_opciones(hash_destruir_dato_t destruir_dato, const hash_opciones_t *opciones){
     hash_t* hash = malloc(sizeof(hash_t));
     if(!hash) return NULL;
-    lista_t** tabla = calloc(sizeof(lista_t*), TAM_INICIAL);
+    hash->politica = hash_normalizar_politica(opciones ? &opciones->politica : NULL);
+    size_t tam = hash_tam_para_cantidad(opciones ? opciones->capacidad : 0, hash->politica.factor_carga_max);
+    hash_campo_t* tabla = calloc(tam, sizeof(hash_campo_t));
     if(!tabla){
         free(hash);
         return NULL;
     }
     hash->tabla = tabla;
-    hash->tam = TAM_INICIAL;
+    hash->tam = tam;
+    hash->tam_minimo = tam;
     hash->cant = 0;
+    hash->anterior = NULL;
+    hash->tam_anterior = 0;
+    hash->cant_anterior = 0;
+    hash->migrados = 0;
     hash->destruccion = destruir_dato;
+    hash->funcion = (opciones && opciones->funcion) ? opciones->funcion : hash_funcion_rapida;
+    hash->semilla = (opciones && opciones->semilla) ? opciones->semilla : hash_semilla_aleatoria();
+    hash->redimensiones = 0;
+    hash->segundos_redimension = 0;
+    hash->intern = opciones ? opciones->intern : NULL;
+    hash->tasa_filtro = opciones ? opciones->tasa_falsos_positivos : 0;
+    hash->filtro = NULL;
+    if (hash->tasa_filtro != 0){
+        size_t capacidad = opciones->capacidad > TAM_INICIAL ? opciones->capacidad : TAM_INICIAL;
+        hash->filtro = bloom_crear(capacidad, hash->tasa_filtro);
+        if (!hash->filtro){
+            free(tabla);
+            free(hash);
+            return NULL;
+        }
+    }
+#ifdef HASH_CONTADORES
+    memset(&hash->contadores, 0, sizeof(hash_contadores_t));
+#endif
     return hash;
 }
 
-// Devuelve true si la clave se encuentra en la lista, false en caso contrario.
-bool clave_en_lista(lista_iter_t* iter, const char* clave){
-    while (!lista_iter_al_final(iter)){
-        hash_campo_t* actual = (hash_campo_t*) lista_iter_ver_actual(iter);
-        if(strcmp(actual->clave, clave) == 0){
-            return true;
-        }
-        lista_iter_avanzar(iter);
-    }
-    return false;
+hash_t *hash_crear_con_funcion(hash_destruir_dato_t destruir_dato, hash_funcion_t funcion, uint64_t semilla){
+    hash_opciones_t opciones = {.funcion = funcion, .semilla = semilla};
+    return hash_crear_con_opciones(destruir_dato, &opciones);
 }
 
-// Devuelve false si existe la clave, y en caso contrario cambia el dato de la clave 
-// y devuelve true.
-bool insertado_repetido(lista_t* lista, lista_iter_t* iter, hash_campo_t* campo, hash_destruir_dato_t destruir){
-    bool existe_clave_en_lista = clave_en_lista(iter, campo->clave);
-    if (existe_clave_en_lista){
-        hash_campo_t* actual = (hash_campo_t*) lista_iter_ver_actual(iter);
-        void* dato_liberar = actual->dato_hash;
-        actual->dato_hash = campo->dato_hash;
-        if (destruir) destruir(dato_liberar);
-    }
-    return existe_clave_en_lista;
+hash_t *hash_crear_con_capacidad(hash_destruir_dato_t destruir_dato, size_t capacidad){
+    hash_opciones_t opciones = {.capacidad = capacidad};
+    return hash_crear_con_opciones(destruir_dato, &opciones);
 }
 
-// Devuelve true si existe una lista en la posición de la clave, false en caso contrario.
-bool clave_en_hash(const char* clave, const hash_t* hash, size_t pos){
-    return (hash->tabla[pos] != NULL);
+hash_t *hash_crear(hash_destruir_dato_t destruir_dato){
+    return hash_crear_con_opciones(destruir_dato, NULL);
 }
 
-bool hash_guardar(hash_t *hash, const char *clave, void *dato){
-    double indice_redimension = (double) hash->cant / (double) hash->tam;
-    if(indice_redimension >= FACTOR_CARGA_MAX) {
-        if(!redimensionar_hash(hash, hash->tam * FACTOR_REDIMENSION)) return false;
-    }
-    size_t pos = funcion_hashing(clave) % hash->tam;
-    if (!clave_en_hash(clave, hash, pos)){
-        hash->tabla[pos] = lista_crear();
-        if (!hash->tabla[pos]) return false;
+// Guarda el par (clave, dato) a partir del hash y el largo de la clave ya calculados.
+static bool guardar_con_hash(hash_t* hash, const char* clave, uint64_t h, size_t largo, void* dato){
+    migrar_campos(hash, PASO_MIGRACION);
+    hash_campo_t* actual = buscar_campo(hash, clave, h, largo);
+    if (actual){
+        // Actualizar una clave existente no pide memoria ni redimensiona.
+        void* dato_liberar = actual->dato_hash;
+        actual->dato_hash = dato;
+        if (hash->destruccion) hash->destruccion(dato_liberar);
+        CONTAR(hash, reemplazos);
+        return true;
     }
 
-    lista_iter_t* iter = lista_iter_crear(hash->tabla[pos]);
-    hash_campo_t* campo = crear_campo(clave, dato, hash->destruccion);
-    if (!campo) return false;
-    if (!insertado_repetido(hash->tabla[pos], iter, campo, hash->destruccion)){
-        lista_insertar_primero(hash->tabla[pos], campo);
-        hash->cant ++;
-    }else{
-        free(campo->clave);
-        free(campo);
+    // La carga incluye a los campos que faltan migrar, que van a terminar en la tabla actual.
+    double indice_redimension = (double) hash->cant / (double) hash->tam;
+    if(indice_redimension >= hash->politica.factor_carga_max) {
+        if(!redimensionar_hash(hash, hash->tam * hash->politica.factor_crecimiento)) return false;
+    }
+    hash_campo_t campo;
+    if (largo >= HASH_LARGO_BORRADO || !copiar_clave(hash->intern, &campo, clave, largo)) return false;
+    campo.hash = h;
+    campo.dato_hash = dato;
+    insertar_campo(hash->tabla, hash->tam, campo);
+    hash->cant ++;
+    CONTAR(hash, inserciones);
+    if (hash->filtro){
+        // El filtro cuenta también las claves ya borradas: cuando se llena, se rearma.
+        bloom_agregar_hash(hash->filtro, h);
+        if (bloom_cantidad(hash->filtro) > bloom_capacidad(hash->filtro)) reconstruir_filtro(hash);
     }
-    lista_iter_destruir(iter);  
     return true;
 }
 
-// Borra la clave, destruye el campo y devuelve el dato de la clave. 
-void* borrar_clave(lista_iter_t* iter, hash_t* hash){
-    hash_campo_t* elem = lista_iter_ver_actual(iter);
-    void* dato_devolver = elem->dato_hash;
-    free(elem->clave);
-    free(elem);
-    lista_iter_borrar(iter);
-    hash->cant --;
-    return dato_devolver;
+bool hash_guardar(hash_t *hash, const char *clave, void *dato){
+    size_t largo;
+    uint64_t h = calcular_hash(hash, clave, &largo);
+    return guardar_con_hash(hash, clave, h, largo, dato);
+}
 
+// Borra el campo de la posición recibida y corre hacia atrás a los campos siguientes
+// que estaban desplazados, para que no queden huecos en las secuencias de búsqueda.
+static void borrar_campo(hash_t* hash, size_t pos){
+    liberar_clave(hash->intern, &hash->tabla[pos]);
+    pos = correr_campos(hash->tabla, hash->tam, pos);
+    hash->tabla[pos].dato_hash = NULL;
+    hash->cant --;
 }
 
-void *hash_borrar(hash_t *hash, const char *clave){
-    double indice_redimension = (double) hash->cant / (double) hash->tam;
-    if(indice_redimension < FACTOR_CARGA_MIN && hash->tam > TAM_INICIAL){ 
-        if (!redimensionar_hash(hash, hash->tam / FACTOR_REDIMENSION)) return NULL;
+// Borra la clave a partir de su hash y su largo ya calculados, y devuelve su dato.
+static void* borrar_con_hash(hash_t* hash, const char* clave, uint64_t h, size_t largo){
+    migrar_campos(hash, PASO_MIGRACION);
+    if (hash->filtro && !bloom_contiene_hash(hash->filtro, h)) return NULL;
+    CONTAR(hash, busquedas);
+    void* dato;
+    size_t pos = buscar_posicion(hash->tabla, hash->tam, clave, h, largo, SONDEOS(hash));
+    if (pos != hash->tam){
+        dato = hash->tabla[pos].dato_hash;
+        borrar_campo(hash, pos);
+    }else{
+        if (!hash->anterior) return NULL;
+        // En la tabla anterior no se corren los campos: se deja la marca de borrado.
+        pos = buscar_posicion(hash->anterior, hash->tam_anterior, clave, h, largo, SONDEOS(hash));
+        if (pos == hash->tam_anterior) return NULL;
+        hash_campo_t* campo = &hash->anterior[pos];
+        dato = campo->dato_hash;
+        liberar_clave(hash->intern, campo);
+        campo->largo = HASH_LARGO_BORRADO;
+        hash->cant_anterior --;
+        hash->cant --;
+        migrar_campos(hash, 0);
     }
-    size_t pos = funcion_hashing(clave) % hash->tam;
-    if (!clave_en_hash(clave, hash, pos)) return NULL;
-
-    lista_iter_t* iter = lista_iter_crear(hash->tabla[pos]);
-    if (!iter) return NULL;
-    void* dato = NULL;
-    if (clave_en_lista(iter, clave)){ 
-        dato = borrar_clave(iter, hash);
-        if (lista_esta_vacia(hash->tabla[pos])){
-            lista_destruir(hash->tabla[pos], NULL);
-            hash->tabla[pos] = NULL; 
-        } 
+    CONTAR(hash, borrados);
+
+    // Sólo se achica la tabla cuando efectivamente se borró una clave, y hasta un
+    // tamaño en el que la carga quede a mitad de camino entre el mínimo y el máximo.
+    // Si no se consigue la tabla más chica se sigue con la actual.
+    double indice_redimension = (double) hash->cant / (double) hash->tam;
+    if(!hash->anterior && indice_redimension < hash->politica.factor_carga_min && hash->tam > hash->tam_minimo){
+        double carga_objetivo = (hash->politica.factor_carga_min + hash->politica.factor_carga_max) / 2;
+        size_t nuevo_tam = hash_tam_para_cantidad(hash->cant, carga_objetivo);
+        if (nuevo_tam < hash->tam_minimo) nuevo_tam = hash->tam_minimo;
+        if (nuevo_tam < hash->tam) redimensionar_hash(hash, nuevo_tam);
     }
-    lista_iter_destruir(iter);
     return dato;
 }
 
-void *hash_obtener(const hash_t *hash, const char *clave){
-    size_t pos = funcion_hashing(clave) % hash->tam;
-    if (!clave_en_hash(clave, hash, pos)) return NULL;
-    lista_iter_t* iter = lista_iter_crear(hash->tabla[pos]);
-    if (!iter) return NULL;
+void *hash_borrar(hash_t *hash, const char *clave){
+    size_t largo;
+    uint64_t h = calcular_hash(hash, clave, &largo);
+    return borrar_con_hash(hash, clave, h, largo);
+}
 
-    bool existe_clave_en_lista = clave_en_lista(iter, clave);
-    hash_campo_t* actual = (hash_campo_t*) lista_iter_ver_actual(iter);
-    lista_iter_destruir(iter);
-    if (!existe_clave_en_lista) return NULL;
-    return actual->dato_hash;
+void *hash_obtener(const hash_t *hash, const char *clave){
+    size_t largo;
+    uint64_t h = calcular_hash(hash, clave, &largo);
+    hash_campo_t* campo = buscar_campo(hash, clave, h, largo);
+    if (!campo) return NULL;
+    return campo->dato_hash;
 }
 
 bool hash_pertenece(const hash_t *hash, const char *clave){
-    size_t pos = funcion_hashing(clave) % hash->tam;
-    if (!clave_en_hash(clave, hash, pos)) return false;
-    lista_iter_t* iter = lista_iter_crear(hash->tabla[pos]);
-    if (!iter) return false;
+    size_t largo;
+    uint64_t h = calcular_hash(hash, clave, &largo);
+    return buscar_campo(hash, clave, h, largo) != NULL;
+}
 
-    bool existe_clave_en_lista = clave_en_lista(iter, clave);
-    lista_iter_destruir(iter);
-    return existe_clave_en_lista;
+bool hash_reservar(hash_t *hash, size_t capacidad){
+    size_t tam = hash_tam_para_cantidad(capacidad, hash->politica.factor_carga_max);
+    if (tam > hash->tam_minimo) hash->tam_minimo = tam;
+    if (tam <= hash->tam) return true;
+    return rehacer_tabla(hash, tam);
 }
 
-size_t hash_cantidad(const hash_t *hash){
-    return hash->cant;
+bool hash_compactar(hash_t *hash){
+    hash->tam_minimo = TAM_INICIAL;
+    size_t tam = hash_tam_para_cantidad(hash->cant, hash->politica.factor_carga_max);
+    if (tam >= hash->tam){
+        terminar_migracion(hash);
+        return true;
+    }
+    return rehacer_tabla(hash, tam);
 }
 
-void hash_destruir(hash_t *hash){
-    for (size_t i = 0; i < hash->tam; i++){
-        if (!hash->tabla[i]){
-            continue;
+/* Operaciones por lotes */
+
+// Calcula el hash y el largo de las claves del lote y pide al procesador que traiga
+// a la caché las posiciones donde empieza la búsqueda de cada una, para que esas
+// lecturas se superpongan en lugar de esperarse una a la otra.
+static void preparar_lote(const hash_t* hash, const char* claves[], size_t n, uint64_t hashes[], size_t largos[]){
+    for (size_t i = 0; i < n; i++){
+        hashes[i] = calcular_hash(hash, claves[i], &largos[i]);
+        PREFETCH(&hash->tabla[posicion_ideal(hashes[i], hash->tam)]);
+        if (hash->anterior) PREFETCH(&hash->anterior[posicion_ideal(hashes[i], hash->tam_anterior)]);
+    }
+}
+
+void hash_obtener_lote(const hash_t *hash, const char *claves[], size_t n, void *datos[]){
+    uint64_t hashes[TAM_LOTE];
+    size_t largos[TAM_LOTE];
+    for (size_t inicio = 0; inicio < n; inicio += TAM_LOTE){
+        size_t cant = n - inicio < TAM_LOTE ? n - inicio : TAM_LOTE;
+        preparar_lote(hash, claves + inicio, cant, hashes, largos);
+        for (size_t i = 0; i < cant; i++){
+            hash_campo_t* campo = buscar_campo(hash, claves[inicio + i], hashes[i], largos[i]);
+            datos[inicio + i] = campo ? campo->dato_hash : NULL;
         }
-        while (!lista_esta_vacia(hash->tabla[i])){
-            hash_campo_t* campo = lista_ver_primero(hash->tabla[i]);
-            destruir_campo(campo, hash->destruccion);
-            lista_borrar_primero(hash->tabla[i]);
+    }
+}
+
+bool hash_guardar_lote(hash_t *hash, const char *claves[], void *datos[], size_t n){
+    uint64_t hashes[TAM_LOTE];
+    size_t largos[TAM_LOTE];
+    for (size_t inicio = 0; inicio < n; inicio += TAM_LOTE){
+        size_t cant = n - inicio < TAM_LOTE ? n - inicio : TAM_LOTE;
+        preparar_lote(hash, claves + inicio, cant, hashes, largos);
+        for (size_t i = 0; i < cant; i++){
+            if (!guardar_con_hash(hash, claves[inicio + i], hashes[i], largos[i], datos[inicio + i])) return false;
         }
-        lista_destruir(hash->tabla[i], NULL);
     }
-    free(hash->tabla);
+    return true;
+}
+
+void hash_borrar_lote(hash_t *hash, const char *claves[], size_t n, void *datos[]){
+    uint64_t hashes[TAM_LOTE];
+    size_t largos[TAM_LOTE];
+    for (size_t inicio = 0; inicio < n; inicio += TAM_LOTE){
+        size_t cant = n - inicio < TAM_LOTE ? n - inicio : TAM_LOTE;
+        preparar_lote(hash, claves + inicio, cant, hashes, largos);
+        for (size_t i = 0; i < cant; i++){
+            void* dato = borrar_con_hash(hash, claves[inicio + i], hashes[i], largos[i]);
+            if (datos) datos[inicio + i] = dato;
+        }
+    }
+}
+
+size_t hash_cantidad(const hash_t *hash){
+    return hash->cant;
+}
+
+// Suma a las estadísticas las posiciones ocupadas y los largos de búsqueda de las
+// claves vigentes de la tabla.
+static void sumar_estadisticas_tabla(const hash_campo_t* tabla, size_t tam, hash_estadisticas_t* estadisticas, size_t* total_sondeos){
+    for (size_t i = 0; i < tam; i++){
+        if (tabla[i].dist == 0) continue;
+        estadisticas->ocupadas ++;
+        if (!campo_ocupado(&tabla[i])) continue;
+        size_t sondeo = tabla[i].dist;
+        *total_sondeos += sondeo;
+        if (sondeo > estadisticas->sondeo_max) estadisticas->sondeo_max = sondeo;
+        estadisticas->histograma[sondeo < HASH_HISTOGRAMA ? sondeo - 1 : HASH_HISTOGRAMA - 1] ++;
+    }
+}
+
+hash_estadisticas_t hash_estadisticas(const hash_t *hash){
+    hash_estadisticas_t estadisticas;
+    memset(&estadisticas, 0, sizeof(hash_estadisticas_t));
+    estadisticas.cantidad = hash->cant;
+    estadisticas.tam = hash->tam;
+    estadisticas.tam_anterior = hash->tam_anterior;
+    estadisticas.pendientes = hash->cant_anterior;
+    estadisticas.factor_carga = (double) hash->cant / (double) hash->tam;
+    size_t total_sondeos = 0;
+    sumar_estadisticas_tabla(hash->tabla, hash->tam, &estadisticas, &total_sondeos);
+    if (hash->anterior) sumar_estadisticas_tabla(hash->anterior, hash->tam_anterior, &estadisticas, &total_sondeos);
+    estadisticas.ocupacion = (double) estadisticas.ocupadas / (double) (hash->tam + hash->tam_anterior);
+    if (hash->cant > 0) estadisticas.sondeo_medio = (double) total_sondeos / (double) hash->cant;
+    estadisticas.redimensiones = hash->redimensiones;
+    estadisticas.segundos_redimension = hash->segundos_redimension;
+#ifdef HASH_CONTADORES
+    estadisticas.contadores = hash->contadores;
+#endif
+    return estadisticas;
+}
+
+// Destruye las claves y los datos de los campos vigentes de la tabla, y la libera.
+static void destruir_tabla(const hash_t* hash, hash_campo_t* tabla, size_t tam){
+    for (size_t i = 0; i < tam; i++){
+        if (!campo_ocupado(&tabla[i])) continue;
+        if (hash->destruccion) hash->destruccion(tabla[i].dato_hash);
+        liberar_clave(hash->intern, &tabla[i]);
+    }
+    free(tabla);
+}
+
+void hash_destruir(hash_t *hash){
+    destruir_tabla(hash, hash->tabla, hash->tam);
+    if (hash->anterior) destruir_tabla(hash, hash->anterior, hash->tam_anterior);
+    if (hash->filtro) bloom_destruir(hash->filtro);
     free(hash);
 }
 
+// El iterador recorre primero la tabla anterior (si hay una migración en curso) y
+// luego la actual: las posiciones de la actual se numeran a continuación de las de la anterior.
+// Recorre las posiciones desde pos_iter hasta fin (sin incluirla).
 struct hash_iter{
     const hash_t* hash;
-    lista_iter_t* iter_lista;
     size_t pos_iter;
+    size_t fin;
 };
 
-bool buscar_proxima_lista(hash_iter_t* iter){
-    for (size_t i = iter->pos_iter; i < iter->hash->tam; i++){
-        if (iter->hash->tabla[i] == NULL){
-            iter->pos_iter += 1;
-            continue;
-        }
-        iter->iter_lista = lista_iter_crear(iter->hash->tabla[i]);
-        return true;
+// Devuelve el campo de la posición recibida dentro del recorrido del iterador.
+static hash_campo_t* campo_iter(const hash_iter_t* iter){
+    const hash_t* hash = iter->hash;
+    if (iter->pos_iter < hash->tam_anterior) return &hash->anterior[iter->pos_iter];
+    return &hash->tabla[iter->pos_iter - hash->tam_anterior];
+}
+
+// Avanza la posición del iterador hasta el próximo campo ocupado (o hasta el final).
+static void buscar_proximo_campo(hash_iter_t* iter){
+    while (!hash_iter_al_final(iter) && !campo_ocupado(campo_iter(iter))){
+        iter->pos_iter ++;
     }
-    return false;
 }
 
 hash_iter_t *hash_iter_crear(const hash_t *hash){
+    return hash_iter_rango_crear(hash, 0, 1);
+}
+
+hash_iter_t *hash_iter_rango_crear(const hash_t *hash, size_t parte, size_t partes){
+    if (parte >= partes) return NULL;
     hash_iter_t* iter_hash = malloc(sizeof(hash_iter_t));
     if (!iter_hash) return NULL;
-    iter_hash->pos_iter = 0;
-    iter_hash->iter_lista = NULL;
+    // Las primeras 'resto' partes tienen una posición más que las demás.
+    size_t total = hash->tam_anterior + hash->tam;
+    size_t largo = total / partes, resto = total % partes;
+    iter_hash->pos_iter = parte * largo + (parte < resto ? parte : resto);
+    iter_hash->fin = iter_hash->pos_iter + largo + (parte < resto ? 1 : 0);
     iter_hash->hash = hash;
-    if(!buscar_proxima_lista(iter_hash)){ 
-        iter_hash->pos_iter = hash->tam;
-    }
+    buscar_proximo_campo(iter_hash);
     return iter_hash;
 }
 
 bool hash_iter_avanzar(hash_iter_t *iter){
-    if(hash_iter_al_final(iter)) return false; 
-    lista_iter_avanzar(iter->iter_lista);
-    if (lista_iter_al_final(iter->iter_lista)){
-        lista_iter_destruir(iter->iter_lista);
-        iter->pos_iter ++;
-        if (!buscar_proxima_lista(iter)){
-            return false;
-        }
-    }
-    return true; 
-
+    if(hash_iter_al_final(iter)) return false;
+    iter->pos_iter ++;
+    buscar_proximo_campo(iter);
+    return !hash_iter_al_final(iter);
 }
 
 const char *hash_iter_ver_actual(const hash_iter_t *iter){
     if (hash_iter_al_final(iter)) return NULL;
-    hash_campo_t* campo = lista_iter_ver_actual(iter->iter_lista);
-    return campo->clave;
+    return clave_campo(campo_iter(iter));
+}
+
+void *hash_iter_ver_dato(const hash_iter_t *iter){
+    if (hash_iter_al_final(iter)) return NULL;
+    return campo_iter(iter)->dato_hash;
 }
 
 
 bool hash_iter_al_final(const hash_iter_t *iter){
-    return iter->pos_iter >= iter->hash->tam;
-   
+    return iter->pos_iter >= iter->fin;
+
 }
 
 void hash_iter_destruir(hash_iter_t* iter){
-    if(iter->iter_lista && iter->pos_iter != iter->hash->tam){
-        lista_iter_destruir(iter->iter_lista);
-    }
     free(iter);
 }
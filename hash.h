@@ -3,6 +3,8 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "intern.h"
 
 // Los structs deben llamarse "hash" y "hash_iter".
 struct hash;
@@ -14,12 +16,67 @@ typedef struct hash_iter hash_iter_t;
 // tipo de función para destruir dato
 typedef void (*hash_destruir_dato_t)(void *);
 
+// tipo de función de hashing: recibe la clave, su largo y una semilla, y
+// devuelve un hash de 64 bits. Los bits bajos del resultado deben estar bien
+// distribuidos, porque son los que ubican a la clave en la tabla.
+typedef uint64_t (*hash_funcion_t)(const char *clave, size_t largo, uint64_t semilla);
+
+/* Política de redimensión del hash. La tabla crece (multiplicando su tamaño
+ * por factor_crecimiento) cuando al guardar su carga llega a factor_carga_max,
+ * y se achica cuando al borrar su carga baja de factor_carga_min. Al achicarse
+ * su carga queda a mitad de camino entre ambos factores.
+ * Los valores se corrigen para que sean válidos: factor_carga_max no supera
+ * 0.95, factor_crecimiento se redondea a una potencia de dos, y
+ * factor_carga_min se baja si la tabla recién agrandada ya debiera achicarse.
+ */
+typedef struct hash_politica{
+    double factor_carga_max;    // Por omisión, 0.85.
+    double factor_carga_min;    // Por omisión, 0.2.
+    size_t factor_crecimiento;  // Por omisión, 2.
+}hash_politica_t;
+
+/* Opciones de creación del hash. Los campos en 0 (o NULL) toman el valor
+ * por omisión.
+ * Con tasa_falsos_positivos entre 0 y 1, el hash mantiene un filtro de Bloom
+ * (ver bloom.h) con esa tasa que descarta sin recorrer la tabla a la mayoría
+ * de las claves que no están. Conviene cuando la mayoría de las búsquedas son
+ * de claves ausentes. Las claves borradas siguen marcadas en el filtro hasta
+ * que se rearma, lo que pasa cada vez que se le agregan tantas claves como
+ * tenía el hash al armarlo.
+ */
+typedef struct hash_opciones{
+    hash_funcion_t funcion;     // Por omisión, hash_funcion_rapida.
+    uint64_t semilla;           // Por omisión, una semilla aleatoria propia de la tabla.
+    size_t capacidad;           // Claves que entran sin redimensionar (ver hash_reservar).
+    hash_politica_t politica;
+    intern_t *intern;           // Si no es NULL, las claves largas se toman prestadas de este conjunto
+                                // en lugar de copiarse (las cortas siguen guardándose en la tabla).
+    double tasa_falsos_positivos; // Si no es 0, tasa del filtro de Bloom del hash (ver abajo).
+}hash_opciones_t;
+
 /* Crea el hash
  */
 hash_t *hash_crear(hash_destruir_dato_t destruir_dato);
 
+/* Crea el hash usando la función de hashing y la semilla recibidas. Si la
+ * función es NULL se usa hash_funcion_rapida, y si la semilla es 0 se usa
+ * una semilla aleatoria.
+ */
+hash_t *hash_crear_con_funcion(hash_destruir_dato_t destruir_dato, hash_funcion_t funcion, uint64_t semilla);
+
+/* Crea el hash con lugar para 'capacidad' claves: guardarlas no redimensiona
+ * la tabla.
+ */
+hash_t *hash_crear_con_capacidad(hash_destruir_dato_t destruir_dato, size_t capacidad);
+
+/* Crea el hash con las opciones recibidas (puede ser NULL para usar todas
+ * las opciones por omisión).
+ */
+hash_t *hash_crear_con_opciones(hash_destruir_dato_t destruir_dato, const hash_opciones_t *opciones);
+
 /* Guarda un elemento en el hash, si la clave ya se encuentra en la
- * estructura, la reemplaza. De no poder guardarlo devuelve false.
+ * estructura, la reemplaza (sin pedir memoria). De no poder guardarlo
+ * devuelve false.
  * Pre: La estructura hash fue inicializada
  * Post: Se almacenó el par (clave, dato)
  */
@@ -56,6 +113,88 @@ size_t hash_cantidad(const hash_t *hash);
  */
 void hash_destruir(hash_t *hash);
 
+/* Agranda la tabla (de una sola vez) para que entren 'capacidad' claves sin
+ * redimensionarla, y evita que los borrados la achiquen por debajo de ese
+ * tamaño hasta que se llame a hash_compactar. Devuelve false si no pudo
+ * pedir la memoria; en ese caso el hash queda como estaba.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_reservar(hash_t *hash, size_t capacidad);
+
+/* Achica la tabla (de una sola vez) al menor tamaño en el que entran las
+ * claves guardadas, y deja sin efecto lo reservado con hash_reservar.
+ * Devuelve false si no pudo pedir la memoria; en ese caso la tabla conserva
+ * su tamaño.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_compactar(hash_t *hash);
+
+/* Operaciones por lotes: equivalen a aplicar la primitiva a cada clave en
+ * orden, pero calculan primero los hashes de varias claves y piden sus
+ * posiciones a memoria a la vez, lo que conviene en tablas grandes.
+ */
+
+/* Guarda en datos[i] el dato de claves[i], o NULL si la clave no está.
+ * Pre: La estructura hash fue inicializada y datos tiene lugar para n elementos.
+ */
+void hash_obtener_lote(const hash_t *hash, const char *claves[], size_t n, void *datos[]);
+
+/* Guarda los pares (claves[i], datos[i]). Si no puede guardar alguno devuelve
+ * false; los pares anteriores a ese quedan guardados.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_guardar_lote(hash_t *hash, const char *claves[], void *datos[], size_t n);
+
+/* Borra las claves recibidas y guarda en datos[i] el dato de claves[i], o
+ * NULL si no estaba. Si datos es NULL, los datos borrados no se devuelven.
+ * Pre: La estructura hash fue inicializada
+ */
+void hash_borrar_lote(hash_t *hash, const char *claves[], size_t n, void *datos[]);
+
+/* Estadísticas */
+
+#define HASH_HISTOGRAMA 16 // Largo del histograma de largos de búsqueda.
+
+/* Contadores por operación. Sólo se cuentan si hash.c se compila con
+ * HASH_CONTADORES definido (por ejemplo, con -DHASH_CONTADORES); si no,
+ * quedan en 0. Con los contadores activos, las consultas también modifican
+ * el hash, así que no se puede consultar desde varios hilos a la vez.
+ */
+typedef struct hash_contadores{
+    size_t busquedas;    // Búsquedas de claves, incluidas las que hacen guardar y borrar.
+    size_t sondeos;      // Posiciones recorridas entre todas las búsquedas.
+    size_t inserciones;  // Claves nuevas guardadas.
+    size_t reemplazos;   // Claves que ya estaban y se guardaron con otro dato.
+    size_t borrados;     // Claves borradas (sin contar las que no estaban).
+    size_t migrados;     // Campos movidos de la tabla anterior a la actual.
+}hash_contadores_t;
+
+/* Estado de la tabla en un momento dado. El largo de búsqueda de una clave es
+ * la cantidad de posiciones que recorre hasta encontrarla: 1 si está en su
+ * posición ideal.
+ */
+typedef struct hash_estadisticas{
+    size_t cantidad;
+    size_t tam;                 // Posiciones de la tabla actual.
+    size_t tam_anterior;        // Posiciones de la tabla que se está migrando (0 si no hay migración).
+    size_t pendientes;          // Claves que faltan migrar.
+    size_t ocupadas;            // Posiciones ocupadas de ambas tablas, incluidas las marcas de la anterior.
+    double factor_carga;        // cantidad / tam, el que decide cuándo redimensionar.
+    double ocupacion;           // ocupadas / (tam + tam_anterior).
+    size_t sondeo_max;          // Mayor largo de búsqueda entre las claves guardadas.
+    double sondeo_medio;
+    size_t histograma[HASH_HISTOGRAMA]; // histograma[i]: claves de largo de búsqueda i + 1 (la última posición incluye a las más largas).
+    size_t redimensiones;       // Veces que se cambió el tamaño de la tabla desde su creación.
+    double segundos_redimension; // Tiempo total de esos cambios, sin la migración gradual que hacen las operaciones siguientes.
+    hash_contadores_t contadores;
+}hash_estadisticas_t;
+
+/* Devuelve las estadísticas del hash. Recorre toda la tabla, así que es
+ * O(tamaño de la tabla).
+ * Pre: La estructura hash fue inicializada
+ */
+hash_estadisticas_t hash_estadisticas(const hash_t *hash);
+
 /* Iterador del hash */
 
 // Crea iterador
@@ -64,13 +203,64 @@ hash_iter_t *hash_iter_crear(const hash_t *hash);
 // Avanza iterador
 bool hash_iter_avanzar(hash_iter_t *iter);
 
-// Devuelve clave actual, esa clave no se puede modificar ni liberar.
+// Devuelve clave actual, esa clave no se puede modificar ni liberar. Deja de
+// ser válida al modificar el hash, porque las claves cortas se guardan dentro
+// de la tabla.
 const char *hash_iter_ver_actual(const hash_iter_t *iter);
 
+// Devuelve el dato de la clave actual, o NULL si terminó la iteración.
+void *hash_iter_ver_dato(const hash_iter_t *iter);
+
 // Comprueba si terminó la iteración
 bool hash_iter_al_final(const hash_iter_t *iter);
 
 // Destruye iterador
 void hash_iter_destruir(hash_iter_t* iter);
 
+/* Crea un iterador que recorre sólo la parte número 'parte' (empezando en 0)
+ * de las 'partes' en que se divide la tabla. Los iteradores de las partes
+ * 0 a partes - 1 recorren entre todos cada clave exactamente una vez, y se
+ * pueden usar desde hilos distintos mientras nadie modifique el hash.
+ * Devuelve NULL si parte no es menor que partes o si no hay memoria.
+ */
+hash_iter_t *hash_iter_rango_crear(const hash_t *hash, size_t parte, size_t partes);
+
+/* Funciones de hashing */
+
+/* Función de hashing por omisión. Procesa la clave de a 16 bytes mezclando
+ * cada bloque con la semilla mediante multiplicaciones de 64x64 bits, por lo
+ * que conviene para claves largas.
+ */
+uint64_t hash_funcion_rapida(const char *clave, size_t largo, uint64_t semilla);
+
+/* Función djb2 de Dan Bernstein, partiendo de la semilla y con una mezcla
+ * final de los bits. Procesa la clave de a un byte.
+ */
+uint64_t hash_funcion_djb2(const char *clave, size_t largo, uint64_t semilla);
+
+/* Devuelve una semilla aleatoria distinta en cada llamado (nunca 0).
+ */
+uint64_t hash_semilla_aleatoria(void);
+
+/* Finalizador de MurmurHash3: mezcla los bits del hash para que los bits
+ * bajos, que son los que se usan al enmascarar con el tamaño de la tabla,
+ * dependan de todos los demás. Es biyectivo, así que no agrega colisiones.
+ * Sirve para armar tablas propias con funciones de hashing débiles (por
+ * ejemplo, la identidad para claves enteras).
+ */
+static inline uint64_t hash_mezclar_bits(uint64_t h){
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/* Devuelve el menor tamaño de tabla (potencia de dos, no menor al inicial de
+ * hash_t) en el que entran 'cantidad' claves sin superar el factor de carga
+ * 'factor'. Es el que usa hash_t para 'capacidad' y hash_reservar.
+ */
+size_t hash_tam_para_cantidad(size_t cantidad, double factor);
+
 #endif // HASH_H
@@ -0,0 +1,430 @@
+#define  _POSIX_C_SOURCE 200809L
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__)
+#error "hash_concurrente.c requiere C11 con <stdatomic.h> (por ejemplo, -std=c11)"
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_concurrente.h"
+#include "hash_interno.h"
+
+#define CANT_SEGMENTOS 64 // Debe ser potencia de dos.
+#define BITS_SEGMENTO 6
+#define TAM_LINEA_CACHE 64
+
+// Cada segmento es una tabla Robin Hood como la de hash.c. Las claves se guardan
+// siempre en memoria dinámica, para que un lector que compita con una escritura
+// nunca lea una clave a medio copiar.
+// Los lectores leen los campos mientras un escritor puede estar modificándolos,
+// así que cada miembro es atómico. Las lecturas sueltas pueden no ser coherentes
+// entre sí: el lector las valida con la versión del segmento antes de usarlas.
+typedef struct campo{
+    _Atomic(uint64_t) hash;
+    _Atomic(char*) clave;
+    _Atomic(void*) dato;
+    atomic_size_t largo;
+    atomic_size_t dist;
+}campo_t;
+
+// Copia de los valores de un campo, para moverlos de una posición a otra.
+typedef struct entrada{
+    uint64_t hash;
+    char* clave;
+    void* dato;
+    size_t largo;
+    size_t dist;
+}entrada_t;
+
+typedef struct tabla{
+    size_t tam;
+    campo_t campos[];
+}tabla_t;
+
+// Los escritores de un segmento se excluyen con 'mutex'. Los lectores no toman
+// locks: 'version' es impar mientras un escritor modifica la tabla, y el lector
+// que ve que cambió durante su búsqueda la repite. Además cada lector se anota en
+// 'lectores[epoca % 2]' para que el escritor no libere una tabla o una clave que
+// un lector todavía está recorriendo.
+typedef struct segmento{
+    _Alignas(TAM_LINEA_CACHE) pthread_mutex_t mutex;
+    _Atomic(tabla_t*) tabla;
+    atomic_uint version;
+    atomic_uint epoca;
+    atomic_size_t lectores[2];
+    atomic_size_t cant;
+}segmento_t;
+
+struct hash_concurrente{
+    segmento_t segmentos[CANT_SEGMENTOS];
+    hash_destruir_dato_t destruccion;
+    hash_funcion_t funcion;
+    uint64_t semilla;
+    hash_politica_t politica;
+    size_t tam_minimo; // Tamaño mínimo de la tabla de cada segmento.
+};
+
+// Resultado de una búsqueda sin lock.
+typedef enum busqueda{
+    ENCONTRADA,
+    AUSENTE,
+    REINTENTAR, // La tabla cambió durante la búsqueda.
+}busqueda_t;
+
+/*********************** Tablas ***********************/
+
+static tabla_t* tabla_crear(size_t tam){
+    tabla_t* tabla = calloc(1, sizeof(tabla_t) + tam * sizeof(campo_t));
+    if (!tabla) return NULL;
+    tabla->tam = tam;
+    return tabla;
+}
+
+// Lee y escribe los valores de un campo. Sólo las usan los escritores, con el
+// mutex del segmento tomado. La clave y el dato se publican con release para que
+// el lector que los lee con acquire vea la clave copiada y el dato inicializado.
+static entrada_t leer_campo(const campo_t* campo){
+    entrada_t entrada;
+    entrada.hash = atomic_load_explicit(&campo->hash, memory_order_relaxed);
+    entrada.clave = atomic_load_explicit(&campo->clave, memory_order_relaxed);
+    entrada.dato = atomic_load_explicit(&campo->dato, memory_order_relaxed);
+    entrada.largo = atomic_load_explicit(&campo->largo, memory_order_relaxed);
+    entrada.dist = atomic_load_explicit(&campo->dist, memory_order_relaxed);
+    return entrada;
+}
+
+static void escribir_campo(campo_t* campo, entrada_t entrada){
+    atomic_store_explicit(&campo->hash, entrada.hash, memory_order_relaxed);
+    atomic_store_explicit(&campo->clave, entrada.clave, memory_order_release);
+    atomic_store_explicit(&campo->dato, entrada.dato, memory_order_release);
+    atomic_store_explicit(&campo->largo, entrada.largo, memory_order_relaxed);
+    atomic_store_explicit(&campo->dist, entrada.dist, memory_order_relaxed);
+}
+
+static size_t dist_campo(const campo_t* campo){
+    return atomic_load_explicit(&campo->dist, memory_order_relaxed);
+}
+
+// Inserta la entrada desplazando a las más cercanas a su posición ideal.
+// Pre: la clave no está en la tabla y hay al menos una posición vacía.
+static void tabla_insertar(tabla_t* tabla, entrada_t entrada){
+    size_t mascara = tabla->tam - 1;
+    size_t pos = (size_t) entrada.hash & mascara;
+    entrada.dist = 1;
+    while (dist_campo(&tabla->campos[pos]) != 0){
+        if (dist_campo(&tabla->campos[pos]) < entrada.dist){
+            entrada_t desplazada = leer_campo(&tabla->campos[pos]);
+            escribir_campo(&tabla->campos[pos], entrada);
+            entrada = desplazada;
+        }
+        pos = (pos + 1) & mascara;
+        entrada.dist ++;
+    }
+    escribir_campo(&tabla->campos[pos], entrada);
+}
+
+// Devuelve la posición de la clave en la tabla, o tam si la clave no está.
+// Pre: se tiene el mutex del segmento.
+static size_t tabla_buscar(const tabla_t* tabla, const char* clave, uint64_t hash, size_t largo){
+    size_t mascara = tabla->tam - 1;
+    size_t pos = (size_t) hash & mascara;
+    size_t dist = 1;
+    while (dist_campo(&tabla->campos[pos]) >= dist){
+        entrada_t entrada = leer_campo(&tabla->campos[pos]);
+        if (entrada.hash == hash && entrada.largo == largo && memcmp(entrada.clave, clave, largo) == 0){
+            return pos;
+        }
+        pos = (pos + 1) & mascara;
+        dist ++;
+    }
+    return tabla->tam;
+}
+
+// Borra el campo de la posición recibida corriendo hacia atrás a los siguientes.
+// La posición que queda libre sólo se marca vacía: conserva su clave, que sigue
+// siendo válida hasta que el escritor espere a los lectores y la libere.
+static void tabla_borrar(tabla_t* tabla, size_t pos){
+    size_t mascara = tabla->tam - 1;
+    size_t sig = (pos + 1) & mascara;
+    while (dist_campo(&tabla->campos[sig]) > 1){
+        entrada_t entrada = leer_campo(&tabla->campos[sig]);
+        entrada.dist --;
+        escribir_campo(&tabla->campos[pos], entrada);
+        pos = sig;
+        sig = (sig + 1) & mascara;
+    }
+    atomic_store_explicit(&tabla->campos[pos].dist, 0, memory_order_relaxed);
+}
+
+/*********************** Sincronización ***********************/
+
+// Anota al lector en el contador de la época actual y devuelve su índice.
+static unsigned entrar_lectura(segmento_t* seg){
+    while (true){
+        unsigned epoca = atomic_load(&seg->epoca);
+        atomic_fetch_add(&seg->lectores[epoca % 2], 1);
+        if (atomic_load(&seg->epoca) == epoca) return epoca % 2;
+        atomic_fetch_sub(&seg->lectores[epoca % 2], 1);
+    }
+}
+
+static void salir_lectura(segmento_t* seg, unsigned indice){
+    atomic_fetch_sub(&seg->lectores[indice], 1);
+}
+
+// Cambia de época y espera a que terminen los lectores de la anterior: al volver,
+// ningún lector puede estar usando memoria que se haya desenganchado antes del llamado.
+// Pre: se tiene el mutex del segmento.
+static void esperar_lectores(segmento_t* seg){
+    unsigned epoca = atomic_fetch_add(&seg->epoca, 1);
+    while (atomic_load(&seg->lectores[epoca % 2]) != 0){
+        sched_yield();
+    }
+}
+
+// Marcan el inicio y el fin de una modificación de la tabla del segmento.
+// Pre: se tiene el mutex del segmento.
+static void empezar_escritura(segmento_t* seg){
+    unsigned version = atomic_load_explicit(&seg->version, memory_order_relaxed);
+    atomic_store_explicit(&seg->version, version + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static void terminar_escritura(segmento_t* seg){
+    unsigned version = atomic_load_explicit(&seg->version, memory_order_relaxed);
+    atomic_store_explicit(&seg->version, version + 1, memory_order_release);
+}
+
+// Devuelve true si el segmento sigue en la versión (par) leída al empezar la
+// búsqueda: en ese caso, todo lo leído hasta acá corresponde a una misma versión
+// de la tabla, y las claves leídas todavía no se liberaron.
+static bool version_vigente(const segmento_t* seg, unsigned version){
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&seg->version, memory_order_relaxed) == version;
+}
+
+/*********************** Segmentos ***********************/
+
+// Devuelve el segmento de un hash: se usan los bits altos, ya que los bajos
+// ubican a la clave dentro de la tabla del segmento.
+static segmento_t* buscar_segmento(const hash_concurrente_t* hash, uint64_t h){
+    return (segmento_t*) &hash->segmentos[h >> (64 - BITS_SEGMENTO)];
+}
+
+// Reemplaza la tabla del segmento por una de nuevo_tam con los mismos campos.
+// La tabla anterior se libera una vez que no quedan lectores que puedan estar usándola.
+// Pre: se tiene el mutex del segmento.
+static bool redimensionar_segmento(segmento_t* seg, size_t nuevo_tam){
+    tabla_t* anterior = atomic_load_explicit(&seg->tabla, memory_order_relaxed);
+    tabla_t* nueva = tabla_crear(nuevo_tam);
+    if (!nueva) return false;
+    for (size_t i = 0; i < anterior->tam; i++){
+        if (dist_campo(&anterior->campos[i]) != 0) tabla_insertar(nueva, leer_campo(&anterior->campos[i]));
+    }
+    atomic_store_explicit(&seg->tabla, nueva, memory_order_release);
+    esperar_lectores(seg);
+    free(anterior);
+    return true;
+}
+
+// Busca la clave en la tabla sin tomar locks. Cada campo se lee de a un miembro,
+// y antes de comparar la clave (y de dar por terminada la búsqueda) se valida que
+// la tabla no haya cambiado: así nunca se lee una clave que no corresponda a la
+// posición, y la que se lee no se libera mientras el lector siga anotado.
+// Pre: el lector está anotado en el segmento y 'version' es par.
+static busqueda_t tabla_buscar_sin_lock(const segmento_t* seg, const tabla_t* tabla, unsigned version, const char* clave, uint64_t hash, size_t largo, void** dato){
+    size_t mascara = tabla->tam - 1;
+    size_t pos = (size_t) hash & mascara;
+    for (size_t dist = 1; dist <= tabla->tam; dist++){
+        const campo_t* campo = &tabla->campos[pos];
+        if (dist_campo(campo) < dist) return version_vigente(seg, version) ? AUSENTE : REINTENTAR;
+        if (atomic_load_explicit(&campo->hash, memory_order_relaxed) == hash && atomic_load_explicit(&campo->largo, memory_order_relaxed) == largo){
+            const char* clave_campo = atomic_load_explicit(&campo->clave, memory_order_acquire);
+            void* dato_campo = atomic_load_explicit(&campo->dato, memory_order_acquire);
+            if (!version_vigente(seg, version)) return REINTENTAR;
+            if (memcmp(clave_campo, clave, largo) == 0){
+                *dato = dato_campo;
+                return ENCONTRADA;
+            }
+        }
+        pos = (pos + 1) & mascara;
+    }
+    // Con una tabla coherente siempre hay una posición vacía antes de dar la vuelta.
+    return REINTENTAR;
+}
+
+// Busca la clave en el segmento sin tomar locks. Devuelve true si la encontró,
+// y en ese caso guarda su dato en 'dato'.
+static bool buscar_sin_lock(segmento_t* seg, const char* clave, uint64_t h, size_t largo, void** dato){
+    unsigned indice = entrar_lectura(seg);
+    busqueda_t resultado = REINTENTAR;
+    while (resultado == REINTENTAR){
+        unsigned version = atomic_load_explicit(&seg->version, memory_order_acquire);
+        if (version % 2 != 0){
+            sched_yield();
+            continue;
+        }
+        const tabla_t* tabla = atomic_load_explicit(&seg->tabla, memory_order_acquire);
+        resultado = tabla_buscar_sin_lock(seg, tabla, version, clave, h, largo, dato);
+    }
+    salir_lectura(seg, indice);
+    if (resultado == AUSENTE) *dato = NULL;
+    return resultado == ENCONTRADA;
+}
+
+/*********************** Primitivas ***********************/
+
+hash_concurrente_t *hash_concurrente_crear_con_opciones(hash_destruir_dato_t destruir_dato, const hash_opciones_t *opciones){
+    // Ni el intern_t ni el filtro de Bloom admiten escrituras concurrentes.
+    if (opciones && (opciones->intern || opciones->tasa_falsos_positivos != 0)) return NULL;
+    void* memoria = NULL;
+    if (posix_memalign(&memoria, TAM_LINEA_CACHE, sizeof(hash_concurrente_t)) != 0) return NULL;
+    hash_concurrente_t* hash = memoria;
+    hash->politica = hash_normalizar_politica(opciones ? &opciones->politica : NULL);
+    // La capacidad se reparte entre los segmentos, con un margen porque las
+    // claves no se reparten exactamente parejo.
+    size_t capacidad = opciones ? opciones->capacidad : 0;
+    size_t por_segmento = capacidad / CANT_SEGMENTOS + capacidad / (4 * CANT_SEGMENTOS);
+    hash->tam_minimo = hash_tam_para_cantidad(por_segmento, hash->politica.factor_carga_max);
+    for (size_t i = 0; i < CANT_SEGMENTOS; i++){
+        segmento_t* seg = &hash->segmentos[i];
+        tabla_t* tabla = tabla_crear(hash->tam_minimo);
+        if (!tabla || pthread_mutex_init(&seg->mutex, NULL) != 0){
+            free(tabla);
+            for (size_t j = 0; j < i; j++){
+                pthread_mutex_destroy(&hash->segmentos[j].mutex);
+                free(atomic_load(&hash->segmentos[j].tabla));
+            }
+            free(hash);
+            return NULL;
+        }
+        atomic_init(&seg->tabla, tabla);
+        atomic_init(&seg->version, 0);
+        atomic_init(&seg->epoca, 0);
+        atomic_init(&seg->lectores[0], 0);
+        atomic_init(&seg->lectores[1], 0);
+        atomic_init(&seg->cant, 0);
+    }
+    hash->destruccion = destruir_dato;
+    hash->funcion = (opciones && opciones->funcion) ? opciones->funcion : hash_funcion_rapida;
+    hash->semilla = (opciones && opciones->semilla) ? opciones->semilla : hash_semilla_aleatoria();
+    return hash;
+}
+
+hash_concurrente_t *hash_concurrente_crear(hash_destruir_dato_t destruir_dato){
+    return hash_concurrente_crear_con_opciones(destruir_dato, NULL);
+}
+
+bool hash_concurrente_guardar(hash_concurrente_t *hash, const char *clave, void *dato){
+    size_t largo = strlen(clave);
+    uint64_t h = hash->funcion(clave, largo, hash->semilla);
+    segmento_t* seg = buscar_segmento(hash, h);
+
+    pthread_mutex_lock(&seg->mutex);
+    tabla_t* tabla = atomic_load_explicit(&seg->tabla, memory_order_relaxed);
+    size_t pos = tabla_buscar(tabla, clave, h, largo);
+    if (pos != tabla->tam){
+        // Cambiar sólo el dato deja al campo coherente: no hace falta cambiar de versión.
+        void* dato_liberar = atomic_load_explicit(&tabla->campos[pos].dato, memory_order_relaxed);
+        atomic_store_explicit(&tabla->campos[pos].dato, dato, memory_order_release);
+        pthread_mutex_unlock(&seg->mutex);
+        if (hash->destruccion) hash->destruccion(dato_liberar);
+        return true;
+    }
+
+    size_t cant = atomic_load_explicit(&seg->cant, memory_order_relaxed);
+    if ((double) cant / (double) tabla->tam >= hash->politica.factor_carga_max){
+        if (!redimensionar_segmento(seg, tabla->tam * hash->politica.factor_crecimiento)){
+            pthread_mutex_unlock(&seg->mutex);
+            return false;
+        }
+        tabla = atomic_load_explicit(&seg->tabla, memory_order_relaxed);
+    }
+    entrada_t entrada = {h, malloc(largo + 1), dato, largo, 0};
+    if (!entrada.clave){
+        pthread_mutex_unlock(&seg->mutex);
+        return false;
+    }
+    memcpy(entrada.clave, clave, largo + 1);
+    empezar_escritura(seg);
+    tabla_insertar(tabla, entrada);
+    terminar_escritura(seg);
+    atomic_store_explicit(&seg->cant, cant + 1, memory_order_relaxed);
+    pthread_mutex_unlock(&seg->mutex);
+    return true;
+}
+
+void *hash_concurrente_borrar(hash_concurrente_t *hash, const char *clave){
+    size_t largo = strlen(clave);
+    uint64_t h = hash->funcion(clave, largo, hash->semilla);
+    segmento_t* seg = buscar_segmento(hash, h);
+
+    pthread_mutex_lock(&seg->mutex);
+    tabla_t* tabla = atomic_load_explicit(&seg->tabla, memory_order_relaxed);
+    size_t pos = tabla_buscar(tabla, clave, h, largo);
+    if (pos == tabla->tam){
+        pthread_mutex_unlock(&seg->mutex);
+        return NULL;
+    }
+    entrada_t borrada = leer_campo(&tabla->campos[pos]);
+    empezar_escritura(seg);
+    tabla_borrar(tabla, pos);
+    terminar_escritura(seg);
+    size_t cant = atomic_load_explicit(&seg->cant, memory_order_relaxed) - 1;
+    atomic_store_explicit(&seg->cant, cant, memory_order_relaxed);
+
+    // Se achica como en hash.c. Si no se consigue la tabla más chica se sigue con
+    // la actual, pero igual hay que esperar a los lectores antes de liberar la clave.
+    bool achicado = false;
+    if ((double) cant / (double) tabla->tam < hash->politica.factor_carga_min && tabla->tam > hash->tam_minimo){
+        double carga_objetivo = (hash->politica.factor_carga_min + hash->politica.factor_carga_max) / 2;
+        size_t nuevo_tam = hash_tam_para_cantidad(cant, carga_objetivo);
+        if (nuevo_tam < hash->tam_minimo) nuevo_tam = hash->tam_minimo;
+        if (nuevo_tam < tabla->tam) achicado = redimensionar_segmento(seg, nuevo_tam);
+    }
+    if (!achicado) esperar_lectores(seg);
+    pthread_mutex_unlock(&seg->mutex);
+    free(borrada.clave);
+    return borrada.dato;
+}
+
+void *hash_concurrente_obtener(const hash_concurrente_t *hash, const char *clave){
+    size_t largo = strlen(clave);
+    uint64_t h = hash->funcion(clave, largo, hash->semilla);
+    void* dato;
+    buscar_sin_lock(buscar_segmento(hash, h), clave, h, largo, &dato);
+    return dato;
+}
+
+bool hash_concurrente_pertenece(const hash_concurrente_t *hash, const char *clave){
+    size_t largo = strlen(clave);
+    uint64_t h = hash->funcion(clave, largo, hash->semilla);
+    void* dato;
+    return buscar_sin_lock(buscar_segmento(hash, h), clave, h, largo, &dato);
+}
+
+size_t hash_concurrente_cantidad(const hash_concurrente_t *hash){
+    size_t cant = 0;
+    for (size_t i = 0; i < CANT_SEGMENTOS; i++){
+        cant += atomic_load_explicit(&hash->segmentos[i].cant, memory_order_relaxed);
+    }
+    return cant;
+}
+
+void hash_concurrente_destruir(hash_concurrente_t *hash){
+    for (size_t i = 0; i < CANT_SEGMENTOS; i++){
+        segmento_t* seg = &hash->segmentos[i];
+        tabla_t* tabla = atomic_load(&seg->tabla);
+        for (size_t j = 0; j < tabla->tam; j++){
+            if (dist_campo(&tabla->campos[j]) == 0) continue;
+            entrada_t entrada = leer_campo(&tabla->campos[j]);
+            if (hash->destruccion) hash->destruccion(entrada.dato);
+            free(entrada.clave);
+        }
+        free(tabla);
+        pthread_mutex_destroy(&seg->mutex);
+    }
+    free(hash);
+}
@@ -0,0 +1,73 @@
+#ifndef HASH_CONCURRENTE_H
+#define HASH_CONCURRENTE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* Hash seguro para usar desde varios hilos a la vez. Las claves se reparten
+ * en segmentos, cada uno con su propia tabla y su propio lock de escritura,
+ * de modo que escrituras sobre segmentos distintos no se bloquean entre sí.
+ * Las lecturas (obtener, pertenece) no toman ningún lock: se reintentan si
+ * una escritura modificó el segmento mientras buscaban.
+ *
+ * Si se usa una función de destrucción, el dato devuelto por obtener sólo es
+ * válido mientras ningún otro hilo reemplace o borre esa clave.
+ *
+ * hash_concurrente.c requiere C11 (usa <stdatomic.h>) y POSIX threads.
+ */
+struct hash_concurrente;
+typedef struct hash_concurrente hash_concurrente_t;
+
+/* Crea el hash concurrente.
+ */
+hash_concurrente_t *hash_concurrente_crear(hash_destruir_dato_t destruir_dato);
+
+/* Crea el hash concurrente con las opciones recibidas (puede ser NULL para
+ * usar todas las opciones por omisión). Se usan la función de hashing, la
+ * semilla, la política de redimensión (que se aplica a cada segmento) y la
+ * capacidad, que se reparte entre los segmentos. No admite intern ni
+ * tasa_falsos_positivos: si alguna no es 0 devuelve NULL.
+ */
+hash_concurrente_t *hash_concurrente_crear_con_opciones(hash_destruir_dato_t destruir_dato, const hash_opciones_t *opciones);
+
+/* Guarda un elemento en el hash, si la clave ya se encuentra en la
+ * estructura, la reemplaza. De no poder guardarlo devuelve false.
+ * Pre: La estructura hash fue inicializada
+ * Post: Se almacenó el par (clave, dato)
+ */
+bool hash_concurrente_guardar(hash_concurrente_t *hash, const char *clave, void *dato);
+
+/* Borra un elemento del hash y devuelve el dato asociado. Devuelve
+ * NULL si el dato no estaba.
+ * Pre: La estructura hash fue inicializada
+ * Post: El elemento fue borrado de la estructura y se lo devolvió,
+ * en el caso de que estuviera guardado.
+ */
+void *hash_concurrente_borrar(hash_concurrente_t *hash, const char *clave);
+
+/* Obtiene el valor de un elemento del hash, si la clave no se encuentra
+ * devuelve NULL. No toma locks.
+ * Pre: La estructura hash fue inicializada
+ */
+void *hash_concurrente_obtener(const hash_concurrente_t *hash, const char *clave);
+
+/* Determina si clave pertenece o no al hash. No toma locks.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_concurrente_pertenece(const hash_concurrente_t *hash, const char *clave);
+
+/* Devuelve la cantidad de elementos del hash. Si hay escrituras en curso,
+ * el resultado puede no incluirlas.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_concurrente_cantidad(const hash_concurrente_t *hash);
+
+/* Destruye la estructura liberando la memoria pedida y llamando a la función
+ * destruir para cada par (clave, dato).
+ * Pre: La estructura hash fue inicializada y ningún otro hilo la está usando.
+ * Post: La estructura hash fue destruida
+ */
+void hash_concurrente_destruir(hash_concurrente_t *hash);
+
+#endif // HASH_CONCURRENTE_H
@@ -0,0 +1,241 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_congelado.h"
+#include "hash_interno.h"
+
+#define CLAVES_POR_BALDE 4 // Cantidad media de claves por balde.
+#define MAX_DESPLAZAMIENTOS (1u << 20) // Intentos por balde antes de probar otra semilla.
+#define MAX_SEMILLAS 8
+#define BIT_DIRECTO 0x80000000u // Marca los baldes de una sola clave, que guardan su posición.
+
+/* Cada clave cae en un balde según su hash. Para cada balde se guarda un
+ * desplazamiento 'd' tal que las posiciones posicion_clave(hash, d) de todas sus
+ * claves quedan libres y son distintas entre sí. Los baldes de una sola clave
+ * guardan directamente su posición, marcada con BIT_DIRECTO.
+ * Como en hash.c, las claves cortas se guardan dentro de la entrada; las largas
+ * apuntan al bloque de claves.
+ */
+typedef struct entrada{
+    uint64_t hash;
+    union{
+        const char* larga;
+        char corta[HASH_CLAVE_CORTA_MAX + 1];
+    }clave;
+    void* dato;
+    size_t largo;
+}entrada_t;
+
+struct hash_congelado{
+    entrada_t* entradas;        // 'cant' entradas, una por posición.
+    uint32_t* desplazamientos;  // 'baldes' desplazamientos, uno por balde.
+    char* claves;               // Todas las claves, una detrás de otra.
+    size_t cant;
+    size_t baldes;
+    uint64_t semilla;
+};
+
+static const char* clave_entrada(const entrada_t* entrada){
+    if (entrada->largo <= HASH_CLAVE_CORTA_MAX) return entrada->clave.corta;
+    return entrada->clave.larga;
+}
+
+// Lleva un valor de 32 bits al rango [0, n) con una multiplicación en lugar de una división.
+static size_t reducir(uint32_t valor, size_t n){
+    return (size_t) (((uint64_t) valor * n) >> 32);
+}
+
+static size_t balde_clave(uint64_t hash, size_t baldes){
+    return reducir((uint32_t) (hash >> 32), baldes);
+}
+
+static size_t posicion_clave(uint64_t hash, uint32_t desplazamiento, size_t cant){
+    return reducir((uint32_t) hash_mezclar_bits(hash ^ ((uint64_t) desplazamiento * 0x9e3779b97f4a7c15ULL)), cant);
+}
+
+// Devuelve la posición de la clave de hash dado, según el desplazamiento de su balde.
+static size_t posicion(const hash_congelado_t* hash, uint64_t h){
+    uint32_t desplazamiento = hash->desplazamientos[balde_clave(h, hash->baldes)];
+    if (desplazamiento & BIT_DIRECTO) return desplazamiento & ~BIT_DIRECTO;
+    return posicion_clave(h, desplazamiento, hash->cant);
+}
+
+/*********************** Construcción ***********************/
+
+// Arma una entrada por clave del hash. Las claves largas se copian a un único bloque.
+static bool copiar_entradas(hash_congelado_t* congelado, const hash_t* hash, entrada_t* entradas){
+    hash_iter_t* iter = hash_iter_crear(hash);
+    if (!iter) return false;
+    size_t total = 0;
+    for (size_t i = 0; i < congelado->cant; i++, hash_iter_avanzar(iter)){
+        entradas[i].clave.larga = hash_iter_ver_actual(iter);
+        entradas[i].largo = strlen(entradas[i].clave.larga);
+        entradas[i].dato = hash_iter_ver_dato(iter);
+        if (entradas[i].largo > HASH_CLAVE_CORTA_MAX) total += entradas[i].largo + 1;
+    }
+    hash_iter_destruir(iter);
+
+    congelado->claves = malloc(total ? total : 1);
+    if (!congelado->claves) return false;
+    char* destino = congelado->claves;
+    for (size_t i = 0; i < congelado->cant; i++){
+        const char* origen = entradas[i].clave.larga;
+        if (entradas[i].largo <= HASH_CLAVE_CORTA_MAX){
+            memcpy(entradas[i].clave.corta, origen, entradas[i].largo + 1);
+            continue;
+        }
+        memcpy(destino, origen, entradas[i].largo + 1);
+        entradas[i].clave.larga = destino;
+        destino += entradas[i].largo + 1;
+    }
+    return true;
+}
+
+// Busca el primer desplazamiento que ubica a todas las claves del balde en
+// posiciones libres y distintas, y las marca como ocupadas. Devuelve false si
+// no lo encontró en MAX_DESPLAZAMIENTOS intentos.
+static bool ubicar_balde(hash_congelado_t* congelado, const entrada_t* entradas, const size_t* indices, size_t tam_balde, bool* ocupado, size_t* posiciones, size_t balde){
+    for (uint32_t d = 0; d < MAX_DESPLAZAMIENTOS; d++){
+        size_t i = 0;
+        for (; i < tam_balde; i++){
+            posiciones[i] = posicion_clave(entradas[indices[i]].hash, d, congelado->cant);
+            if (ocupado[posiciones[i]]) break;
+            ocupado[posiciones[i]] = true;
+        }
+        if (i == tam_balde){
+            congelado->desplazamientos[balde] = d;
+            return true;
+        }
+        while (i > 0) ocupado[posiciones[--i]] = false;
+    }
+    return false;
+}
+
+// Calcula los desplazamientos para la semilla del hash congelado y ubica cada
+// entrada en su posición. Devuelve false si falta memoria o si con esta semilla
+// algún balde no pudo ubicarse.
+static bool construir(hash_congelado_t* congelado, entrada_t* entradas){
+    size_t n = congelado->cant, baldes = congelado->baldes;
+    size_t* inicio = calloc(baldes + 1, sizeof(size_t));
+    size_t* indices = malloc(n * sizeof(size_t));
+    size_t* orden = malloc(baldes * sizeof(size_t));
+    size_t* pos_entrada = malloc(n * sizeof(size_t));
+    bool* ocupado = calloc(n, sizeof(bool));
+    bool ok = inicio && indices && orden && pos_entrada && ocupado;
+
+    if (ok){
+        // Ordena los índices de las entradas por balde (counting sort).
+        for (size_t i = 0; i < n; i++){
+            entradas[i].hash = hash_funcion_rapida(clave_entrada(&entradas[i]), entradas[i].largo, congelado->semilla);
+            inicio[balde_clave(entradas[i].hash, baldes) + 1] ++;
+        }
+        for (size_t b = 0; b < baldes; b++) inicio[b + 1] += inicio[b];
+        size_t* siguiente = orden; // Se usa como auxiliar antes de ordenar los baldes.
+        memcpy(siguiente, inicio, baldes * sizeof(size_t));
+        for (size_t i = 0; i < n; i++) indices[siguiente[balde_clave(entradas[i].hash, baldes)] ++] = i;
+
+        // Ordena los baldes de mayor a menor cantidad de claves (counting sort).
+        size_t max_balde = 0;
+        for (size_t b = 0; b < baldes; b++){
+            if (inicio[b + 1] - inicio[b] > max_balde) max_balde = inicio[b + 1] - inicio[b];
+        }
+        size_t* por_tam = calloc(max_balde + 2, sizeof(size_t));
+        ok = por_tam != NULL;
+        if (ok){
+            for (size_t b = 0; b < baldes; b++) por_tam[max_balde - (inicio[b + 1] - inicio[b]) + 1] ++;
+            for (size_t t = 0; t <= max_balde; t++) por_tam[t + 1] += por_tam[t];
+            for (size_t b = 0; b < baldes; b++) orden[por_tam[max_balde - (inicio[b + 1] - inicio[b])] ++] = b;
+            free(por_tam);
+        }
+    }
+
+    size_t libre = 0;
+    size_t posiciones[64];
+    for (size_t k = 0; ok && k < baldes; k++){
+        size_t b = orden[k];
+        size_t tam_balde = inicio[b + 1] - inicio[b];
+        const size_t* claves_balde = &indices[inicio[b]];
+        if (tam_balde == 0){
+            congelado->desplazamientos[b] = 0;
+        }else if (tam_balde == 1){
+            // Los baldes de una clave, que quedan al final, van a la próxima posición libre.
+            while (ocupado[libre]) libre ++;
+            ocupado[libre] = true;
+            congelado->desplazamientos[b] = (uint32_t) libre | BIT_DIRECTO;
+        }else{
+            ok = tam_balde <= sizeof(posiciones) / sizeof(size_t);
+            ok = ok && ubicar_balde(congelado, entradas, claves_balde, tam_balde, ocupado, posiciones, b);
+        }
+    }
+    for (size_t i = 0; ok && i < n; i++){
+        pos_entrada[i] = posicion(congelado, entradas[i].hash);
+    }
+    for (size_t i = 0; ok && i < n; i++){
+        congelado->entradas[pos_entrada[i]] = entradas[i];
+    }
+    free(inicio);
+    free(indices);
+    free(orden);
+    free(pos_entrada);
+    free(ocupado);
+    return ok;
+}
+
+hash_congelado_t *hash_congelar(const hash_t *hash){
+    hash_congelado_t* congelado = malloc(sizeof(hash_congelado_t));
+    if (!congelado) return NULL;
+    congelado->cant = hash_cantidad(hash);
+    congelado->baldes = congelado->cant / CLAVES_POR_BALDE + 1;
+    congelado->claves = NULL;
+    congelado->entradas = malloc((congelado->cant ? congelado->cant : 1) * sizeof(entrada_t));
+    congelado->desplazamientos = calloc(congelado->baldes, sizeof(uint32_t));
+    entrada_t* entradas = malloc((congelado->cant ? congelado->cant : 1) * sizeof(entrada_t));
+    bool ok = congelado->cant < BIT_DIRECTO && congelado->entradas && congelado->desplazamientos && entradas;
+    ok = ok && copiar_entradas(congelado, hash, entradas);
+
+    // Con otra semilla cambian todos los baldes, así que se reintenta desde cero.
+    bool construido = false;
+    for (size_t intento = 0; ok && !construido && intento < MAX_SEMILLAS; intento++){
+        congelado->semilla = hash_semilla_aleatoria();
+        construido = construir(congelado, entradas);
+    }
+    free(entradas);
+    if (!construido){
+        hash_congelado_destruir(congelado);
+        return NULL;
+    }
+    return congelado;
+}
+
+/*********************** Consultas ***********************/
+
+// Devuelve la entrada de la clave, o NULL si la clave no está.
+static const entrada_t* buscar_entrada(const hash_congelado_t* hash, const char* clave){
+    if (hash->cant == 0) return NULL;
+    size_t largo = strlen(clave);
+    uint64_t h = hash_funcion_rapida(clave, largo, hash->semilla);
+    const entrada_t* entrada = &hash->entradas[posicion(hash, h)];
+    if (entrada->hash != h || entrada->largo != largo || memcmp(clave_entrada(entrada), clave, largo) != 0) return NULL;
+    return entrada;
+}
+
+void *hash_congelado_obtener(const hash_congelado_t *hash, const char *clave){
+    const entrada_t* entrada = buscar_entrada(hash, clave);
+    return entrada ? entrada->dato : NULL;
+}
+
+bool hash_congelado_pertenece(const hash_congelado_t *hash, const char *clave){
+    return buscar_entrada(hash, clave) != NULL;
+}
+
+size_t hash_congelado_cantidad(const hash_congelado_t *hash){
+    return hash->cant;
+}
+
+void hash_congelado_destruir(hash_congelado_t *hash){
+    free(hash->entradas);
+    free(hash->desplazamientos);
+    free(hash->claves);
+    free(hash);
+}
@@ -0,0 +1,47 @@
+#ifndef HASH_CONGELADO_H
+#define HASH_CONGELADO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* Versión inmutable de un hash para tablas que se cargan una vez y luego sólo
+ * se consultan. Se arma con una función de hash perfecta mínima (al estilo
+ * "hash and displace"/CHD): cada clave tiene su propia posición en un arreglo
+ * de exactamente tantas posiciones como claves, por lo que toda búsqueda mira
+ * una sola posición y no hay posiciones vacías.
+ *
+ * El hash congelado copia las claves pero no los datos: guarda los mismos
+ * punteros que el hash original y no los destruye.
+ */
+struct hash_congelado;
+typedef struct hash_congelado hash_congelado_t;
+
+/* Arma el hash congelado con las claves y datos del hash recibido, que no se
+ * modifica. Devuelve NULL si no pudo pedir la memoria.
+ * Pre: La estructura hash fue inicializada
+ */
+hash_congelado_t *hash_congelar(const hash_t *hash);
+
+/* Obtiene el valor de un elemento del hash, si la clave no se encuentra
+ * devuelve NULL.
+ * Pre: El hash congelado fue creado
+ */
+void *hash_congelado_obtener(const hash_congelado_t *hash, const char *clave);
+
+/* Determina si clave pertenece o no al hash.
+ * Pre: El hash congelado fue creado
+ */
+bool hash_congelado_pertenece(const hash_congelado_t *hash, const char *clave);
+
+/* Devuelve la cantidad de elementos del hash.
+ * Pre: El hash congelado fue creado
+ */
+size_t hash_congelado_cantidad(const hash_congelado_t *hash);
+
+/* Destruye el hash congelado. Los datos no se destruyen.
+ * Pre: El hash congelado fue creado
+ */
+void hash_congelado_destruir(hash_congelado_t *hash);
+
+#endif // HASH_CONGELADO_H
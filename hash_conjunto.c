@@ -0,0 +1,265 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_conjunto.h"
+#include "hash_interno.h"
+
+// La tabla es la de hash.c sin el dato (ver HASH_TABLA_DEFINIR en hash_interno.h),
+// y sigue la misma política de redimensión, pero se redimensiona de una sola vez.
+typedef struct campo{
+    uint64_t hash;
+    union{
+        char* larga;
+        char corta[HASH_CLAVE_CORTA_MAX + 1];
+    }clave;
+    uint32_t largo;
+    uint32_t dist;
+}campo_t;
+
+HASH_TABLA_DEFINIR(campo_t)
+
+struct hash_conjunto{
+    campo_t* tabla;
+    size_t cant;
+    size_t tam;
+    size_t tam_minimo;
+    hash_politica_t politica;
+    hash_funcion_t funcion;
+    uint64_t semilla;
+};
+
+/*********************** Tabla ***********************/
+
+// Devuelve la posición de la clave (de hash y largo dados), o tam si no está.
+static size_t buscar_en(const hash_conjunto_t* conjunto, const char* clave, uint64_t hash, size_t largo){
+    return buscar_posicion(conjunto->tabla, conjunto->tam, clave, hash, largo, NULL);
+}
+
+static bool redimensionar(hash_conjunto_t* conjunto, size_t nuevo_tam){
+    campo_t* nueva_tabla = calloc(nuevo_tam, sizeof(campo_t));
+    if (!nueva_tabla) return false;
+    for (size_t i = 0; i < conjunto->tam; i++){
+        if (conjunto->tabla[i].dist != 0) insertar_campo(nueva_tabla, nuevo_tam, conjunto->tabla[i]);
+    }
+    free(conjunto->tabla);
+    conjunto->tabla = nueva_tabla;
+    conjunto->tam = nuevo_tam;
+    return true;
+}
+
+/*********************** Primitivas ***********************/
+
+// Semilla por omisión, elegida al azar una vez y compartida por todos los conjuntos
+// del proceso, para que las operaciones entre conjuntos creados por separado
+// reutilicen los hashes guardados. Se elige con pthread_once, así que se pueden
+// crear conjuntos desde varios hilos a la vez.
+static uint64_t semilla_por_omision = 0;
+static pthread_once_t semilla_elegida = PTHREAD_ONCE_INIT;
+
+static void elegir_semilla(void){
+    semilla_por_omision = hash_semilla_aleatoria();
+}
+
+static uint64_t semilla_compartida(void){
+    pthread_once(&semilla_elegida, elegir_semilla);
+    return semilla_por_omision;
+}
+
+hash_conjunto_t *hash_conjunto_crear_con_opciones(const hash_opciones_t *opciones){
+    hash_conjunto_t* conjunto = malloc(sizeof(hash_conjunto_t));
+    if (!conjunto) return NULL;
+    conjunto->politica = hash_normalizar_politica(opciones ? &opciones->politica : NULL);
+    conjunto->tam = hash_tam_para_cantidad(opciones ? opciones->capacidad : 0, conjunto->politica.factor_carga_max);
+    conjunto->tabla = calloc(conjunto->tam, sizeof(campo_t));
+    if (!conjunto->tabla){
+        free(conjunto);
+        return NULL;
+    }
+    conjunto->cant = 0;
+    conjunto->tam_minimo = conjunto->tam;
+    conjunto->funcion = (opciones && opciones->funcion) ? opciones->funcion : hash_funcion_rapida;
+    conjunto->semilla = (opciones && opciones->semilla) ? opciones->semilla : semilla_compartida();
+    return conjunto;
+}
+
+hash_conjunto_t *hash_conjunto_crear(void){
+    return hash_conjunto_crear_con_opciones(NULL);
+}
+
+// Agrega la clave de hash y largo ya calculados.
+// Pre: la clave no está en el conjunto.
+static bool agregar_nueva(hash_conjunto_t* conjunto, const char* clave, uint64_t h, size_t largo){
+    if ((double) (conjunto->cant + 1) > (double) conjunto->tam * conjunto->politica.factor_carga_max){
+        if (!redimensionar(conjunto, conjunto->tam * conjunto->politica.factor_crecimiento)) return false;
+    }
+    campo_t campo;
+    if (largo >= HASH_LARGO_BORRADO || !copiar_clave(NULL, &campo, clave, largo)) return false;
+    campo.hash = h;
+    insertar_campo(conjunto->tabla, conjunto->tam, campo);
+    conjunto->cant ++;
+    return true;
+}
+
+// Agrega la clave de hash y largo ya calculados, si no estaba.
+static bool agregar_con_hash(hash_conjunto_t* conjunto, const char* clave, uint64_t h, size_t largo){
+    if (buscar_en(conjunto, clave, h, largo) != conjunto->tam) return true;
+    return agregar_nueva(conjunto, clave, h, largo);
+}
+
+bool hash_conjunto_agregar(hash_conjunto_t *conjunto, const char *clave){
+    size_t largo = strlen(clave);
+    return agregar_con_hash(conjunto, clave, conjunto->funcion(clave, largo, conjunto->semilla), largo);
+}
+
+bool hash_conjunto_quitar(hash_conjunto_t *conjunto, const char *clave){
+    size_t largo = strlen(clave);
+    size_t pos = buscar_en(conjunto, clave, conjunto->funcion(clave, largo, conjunto->semilla), largo);
+    if (pos == conjunto->tam) return false;
+
+    liberar_clave(NULL, &conjunto->tabla[pos]);
+    correr_campos(conjunto->tabla, conjunto->tam, pos);
+    conjunto->cant --;
+
+    // Como en hash.c, la tabla se achica hasta que la carga quede a mitad de camino
+    // entre el mínimo y el máximo. Si no se consigue la tabla más chica se sigue
+    // con la actual.
+    const hash_politica_t* politica = &conjunto->politica;
+    if ((double) conjunto->cant < (double) conjunto->tam * politica->factor_carga_min && conjunto->tam > conjunto->tam_minimo){
+        size_t nuevo_tam = hash_tam_para_cantidad(conjunto->cant, (politica->factor_carga_min + politica->factor_carga_max) / 2);
+        if (nuevo_tam < conjunto->tam_minimo) nuevo_tam = conjunto->tam_minimo;
+        if (nuevo_tam < conjunto->tam) redimensionar(conjunto, nuevo_tam);
+    }
+    return true;
+}
+
+bool hash_conjunto_pertenece(const hash_conjunto_t *conjunto, const char *clave){
+    size_t largo = strlen(clave);
+    return buscar_en(conjunto, clave, conjunto->funcion(clave, largo, conjunto->semilla), largo) != conjunto->tam;
+}
+
+size_t hash_conjunto_cantidad(const hash_conjunto_t *conjunto){
+    return conjunto->cant;
+}
+
+void hash_conjunto_destruir(hash_conjunto_t *conjunto){
+    for (size_t i = 0; i < conjunto->tam; i++){
+        if (conjunto->tabla[i].dist != 0) liberar_clave(NULL, &conjunto->tabla[i]);
+    }
+    free(conjunto->tabla);
+    free(conjunto);
+}
+
+/*********************** Operaciones entre conjuntos ***********************/
+
+// Devuelve el hash de la clave del campo de 'origen' según la función y la semilla de
+// 'destino': el guardado si ambos conjuntos hashean igual, o uno calculado si no.
+static uint64_t hash_en(const hash_conjunto_t* destino, const hash_conjunto_t* origen, const campo_t* campo){
+    if (destino->funcion == origen->funcion && destino->semilla == origen->semilla) return campo->hash;
+    return destino->funcion(clave_campo(campo), campo->largo, destino->semilla);
+}
+
+// Crea un conjunto vacío con la función, la semilla y la política de 'modelo' y lugar
+// para 'capacidad' claves.
+static hash_conjunto_t* crear_como(const hash_conjunto_t* modelo, size_t capacidad){
+    hash_opciones_t opciones = {.funcion = modelo->funcion, .semilla = modelo->semilla, .capacidad = capacidad,
+                                .politica = modelo->politica};
+    hash_conjunto_t* conjunto = hash_conjunto_crear_con_opciones(&opciones);
+    // El tamaño reservado es sólo para armar el resultado: después puede achicarse.
+    if (conjunto) conjunto->tam_minimo = hash_tam_para_cantidad(0, conjunto->politica.factor_carga_max);
+    return conjunto;
+}
+
+// Agrega al resultado las claves de 'origen' que están (o no están, según
+// 'si_esta') en 'filtro'. Si filtro es NULL agrega todas. Si 'nuevas' es true, ninguna
+// de esas claves puede estar ya en el resultado y no se las busca antes de agregarlas.
+// Devuelve false si no hay memoria.
+static bool agregar_campos(hash_conjunto_t* resultado, const hash_conjunto_t* origen, const hash_conjunto_t* filtro, bool si_esta, bool nuevas){
+    for (size_t i = 0; i < origen->tam; i++){
+        const campo_t* campo = &origen->tabla[i];
+        if (campo->dist == 0) continue;
+        const char* clave = clave_campo(campo);
+        if (filtro){
+            bool esta = buscar_en(filtro, clave, hash_en(filtro, origen, campo), campo->largo) != filtro->tam;
+            if (esta != si_esta) continue;
+        }
+        uint64_t h = hash_en(resultado, origen, campo);
+        bool ok = nuevas ? agregar_nueva(resultado, clave, h, campo->largo) : agregar_con_hash(resultado, clave, h, campo->largo);
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Destruye el resultado si no se pudo armar.
+static hash_conjunto_t* terminar(hash_conjunto_t* resultado, bool ok){
+    if (!ok && resultado){
+        hash_conjunto_destruir(resultado);
+        return NULL;
+    }
+    return resultado;
+}
+
+hash_conjunto_t *hash_conjunto_union(const hash_conjunto_t *a, const hash_conjunto_t *b){
+    hash_conjunto_t* resultado = crear_como(a, a->cant + b->cant);
+    bool ok = resultado && agregar_campos(resultado, a, NULL, true, true) && agregar_campos(resultado, b, NULL, true, false);
+    return terminar(resultado, ok);
+}
+
+hash_conjunto_t *hash_conjunto_interseccion(const hash_conjunto_t *a, const hash_conjunto_t *b){
+    // Se recorre el conjunto más chico y se busca en el otro.
+    const hash_conjunto_t* menor = a->cant <= b->cant ? a : b;
+    const hash_conjunto_t* mayor = menor == a ? b : a;
+    hash_conjunto_t* resultado = crear_como(a, menor->cant);
+    bool ok = resultado && agregar_campos(resultado, menor, mayor, true, true);
+    return terminar(resultado, ok);
+}
+
+hash_conjunto_t *hash_conjunto_diferencia(const hash_conjunto_t *a, const hash_conjunto_t *b){
+    hash_conjunto_t* resultado = crear_como(a, a->cant);
+    bool ok = resultado && agregar_campos(resultado, a, b, false, true);
+    return terminar(resultado, ok);
+}
+
+/*********************** Iterador ***********************/
+
+struct hash_conjunto_iter{
+    const hash_conjunto_t* conjunto;
+    size_t pos;
+};
+
+// Avanza la posición del iterador hasta el próximo campo ocupado (o hasta el final).
+static void buscar_proximo_campo(hash_conjunto_iter_t* iter){
+    while (!hash_conjunto_iter_al_final(iter) && iter->conjunto->tabla[iter->pos].dist == 0){
+        iter->pos ++;
+    }
+}
+
+hash_conjunto_iter_t *hash_conjunto_iter_crear(const hash_conjunto_t *conjunto){
+    hash_conjunto_iter_t* iter = malloc(sizeof(hash_conjunto_iter_t));
+    if (!iter) return NULL;
+    iter->conjunto = conjunto;
+    iter->pos = 0;
+    buscar_proximo_campo(iter);
+    return iter;
+}
+
+bool hash_conjunto_iter_avanzar(hash_conjunto_iter_t *iter){
+    if (hash_conjunto_iter_al_final(iter)) return false;
+    iter->pos ++;
+    buscar_proximo_campo(iter);
+    return !hash_conjunto_iter_al_final(iter);
+}
+
+const char *hash_conjunto_iter_ver_actual(const hash_conjunto_iter_t *iter){
+    if (hash_conjunto_iter_al_final(iter)) return NULL;
+    return clave_campo(&iter->conjunto->tabla[iter->pos]);
+}
+
+bool hash_conjunto_iter_al_final(const hash_conjunto_iter_t *iter){
+    return iter->pos >= iter->conjunto->tam;
+}
+
+void hash_conjunto_iter_destruir(hash_conjunto_iter_t *iter){
+    free(iter);
+}
@@ -0,0 +1,96 @@
+#ifndef HASH_CONJUNTO_H
+#define HASH_CONJUNTO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* Conjunto de claves implementado como el hash, pero sin datos: cada
+ * posición de la tabla guarda sólo la clave, su hash y su largo, por lo que
+ * ocupa menos memoria que un hash_t con datos NULL.
+ *
+ * Las operaciones entre conjuntos (unión, intersección y diferencia) recorren
+ * las tablas posición por posición. Si ambos conjuntos usan la misma función
+ * de hashing y la misma semilla, reutilizan el hash guardado de cada clave en
+ * lugar de volver a calcularlo. Los conjuntos creados sin función ni semilla
+ * comparten una semilla aleatoria elegida una vez por proceso, y los que
+ * devuelven las operaciones usan la de su primer operando, así que en el caso
+ * habitual nunca se recalculan hashes.
+ */
+struct hash_conjunto;
+struct hash_conjunto_iter;
+
+typedef struct hash_conjunto hash_conjunto_t;
+typedef struct hash_conjunto_iter hash_conjunto_iter_t;
+
+/* Crea el conjunto vacío.
+ */
+hash_conjunto_t *hash_conjunto_crear(void);
+
+/* Crea el conjunto con las opciones recibidas (puede ser NULL). Se usan la
+ * función de hashing, la semilla, la capacidad y la política de redimensión,
+ * que se aplica como en hash_t (ver hash_politica_t) salvo que la tabla se
+ * redimensiona de una sola vez. Sin semilla se usa la compartida por los
+ * conjuntos del proceso.
+ */
+hash_conjunto_t *hash_conjunto_crear_con_opciones(const hash_opciones_t *opciones);
+
+/* Agrega la clave al conjunto, si no estaba. Devuelve false si no pudo
+ * pedir la memoria.
+ * Pre: El conjunto fue creado
+ */
+bool hash_conjunto_agregar(hash_conjunto_t *conjunto, const char *clave);
+
+/* Quita la clave del conjunto. Devuelve true si la clave estaba.
+ * Pre: El conjunto fue creado
+ */
+bool hash_conjunto_quitar(hash_conjunto_t *conjunto, const char *clave);
+
+/* Determina si la clave pertenece al conjunto.
+ * Pre: El conjunto fue creado
+ */
+bool hash_conjunto_pertenece(const hash_conjunto_t *conjunto, const char *clave);
+
+/* Devuelve la cantidad de claves del conjunto.
+ * Pre: El conjunto fue creado
+ */
+size_t hash_conjunto_cantidad(const hash_conjunto_t *conjunto);
+
+/* Destruye el conjunto.
+ * Pre: El conjunto fue creado
+ */
+void hash_conjunto_destruir(hash_conjunto_t *conjunto);
+
+/* Operaciones entre conjuntos. Devuelven un conjunto nuevo, con la función de
+ * hashing, la semilla y la política de 'a', o NULL si no hay memoria. No modifican a los
+ * conjuntos recibidos.
+ */
+
+// Claves que están en a o en b.
+hash_conjunto_t *hash_conjunto_union(const hash_conjunto_t *a, const hash_conjunto_t *b);
+
+// Claves que están en a y en b.
+hash_conjunto_t *hash_conjunto_interseccion(const hash_conjunto_t *a, const hash_conjunto_t *b);
+
+// Claves que están en a y no en b.
+hash_conjunto_t *hash_conjunto_diferencia(const hash_conjunto_t *a, const hash_conjunto_t *b);
+
+/* Iterador del conjunto */
+
+// Crea iterador
+hash_conjunto_iter_t *hash_conjunto_iter_crear(const hash_conjunto_t *conjunto);
+
+// Avanza iterador
+bool hash_conjunto_iter_avanzar(hash_conjunto_iter_t *iter);
+
+// Devuelve clave actual, esa clave no se puede modificar ni liberar. Deja de
+// ser válida al modificar el conjunto.
+const char *hash_conjunto_iter_ver_actual(const hash_conjunto_iter_t *iter);
+
+// Comprueba si terminó la iteración
+bool hash_conjunto_iter_al_final(const hash_conjunto_iter_t *iter);
+
+// Destruye iterador
+void hash_conjunto_iter_destruir(hash_conjunto_iter_t *iter);
+
+#endif // HASH_CONJUNTO_H
@@ -0,0 +1,262 @@
+#ifndef HASH_GENERICO_H
+#define HASH_GENERICO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "hash.h"
+
+/* Hashes especializados por tipo. HASH_DEFINIR(nombre, tipo_clave, tipo_valor,
+ * fn_hash, fn_eq) define el tipo nombre_t y sus primitivas como funciones
+ * static inline, de modo que el compilador puede integrar fn_hash y fn_eq en
+ * las búsquedas y las claves y los valores se guardan en la tabla por valor,
+ * sin void* ni memoria aparte por elemento.
+ *
+ *   fn_hash: uint64_t fn_hash(tipo_clave clave). Se mezclan sus bits con la
+ *            semilla del hash antes de usarlo, así que puede ser la identidad
+ *            para claves enteras.
+ *   fn_eq:   bool fn_eq(tipo_clave a, tipo_clave b).
+ *
+ * Por ejemplo, HASH_DEFINIR(hash_int, int, double, hash_generico_entero, hash_generico_iguales_int)
+ * define hash_int_t, hash_int_crear, hash_int_guardar(hash, 3, 1.5), etc.
+ *
+ * La tabla usa Robin Hood con borrado corriendo campos hacia atrás, como la
+ * de hash.c, pero está reimplementada para claves y valores por valor y se
+ * redimensiona de una sola vez. Los factores de carga son fijos:
+ * HASH_GENERICO_CARGA_MAX y HASH_GENERICO_CARGA_MIN, iguales a los que usa
+ * hash_t por omisión (ver hash_politica_t). Como en hash_t, cada hash
+ * recibe al crearse una semilla de hash_semilla_aleatoria, así que hay que
+ * enlazar con hash.c. No hay función de destrucción:
+ * si las claves o los valores apuntan a memoria, la libera quien la pidió.
+ *
+ * Primitivas definidas (con 'nombre' como prefijo):
+ *   nombre_t *nombre_crear(void);
+ *   nombre_t *nombre_crear_con_capacidad(size_t capacidad);
+ *   bool nombre_guardar(nombre_t *hash, tipo_clave clave, tipo_valor valor);
+ *   bool nombre_obtener(const nombre_t *hash, tipo_clave clave, tipo_valor *valor);
+ *   tipo_valor *nombre_obtener_puntero(nombre_t *hash, tipo_clave clave);
+ *   bool nombre_pertenece(const nombre_t *hash, tipo_clave clave);
+ *   bool nombre_borrar(nombre_t *hash, tipo_clave clave, tipo_valor *valor);
+ *   size_t nombre_cantidad(const nombre_t *hash);
+ *   void nombre_destruir(nombre_t *hash);
+ *   bool nombre_inicializar(nombre_t *hash, size_t capacidad);
+ *   void nombre_liberar(nombre_t *hash);
+ * nombre_obtener y nombre_borrar devuelven false si la clave no está, y si no
+ * guardan el valor en *valor (si valor no es NULL). nombre_obtener_puntero
+ * devuelve un puntero al valor dentro de la tabla (o NULL), válido hasta la
+ * próxima modificación. nombre_inicializar y nombre_liberar crean y destruyen
+ * la tabla de un nombre_t que ya tiene su memoria, por ejemplo dentro de otro
+ * struct; nombre_inicializar devuelve false si no hay memoria.
+ *
+ * Iterador (se crea por valor, no hay que destruirlo):
+ *   nombre_iter_t nombre_iter_crear(const nombre_t *hash);
+ *   bool nombre_iter_avanzar(nombre_iter_t *iter);
+ *   tipo_clave nombre_iter_ver_actual(const nombre_iter_t *iter);
+ *   tipo_valor nombre_iter_ver_dato(const nombre_iter_t *iter);
+ *   bool nombre_iter_al_final(const nombre_iter_t *iter);
+ * ver_actual y ver_dato requieren que la iteración no haya terminado.
+ */
+
+#define HASH_GENERICO_CARGA_MAX 0.85
+#define HASH_GENERICO_CARGA_MIN 0.2
+
+// Funciones de hashing y comparación para claves enteras.
+static inline uint64_t hash_generico_entero(uint64_t clave){
+    return clave;
+}
+
+static inline bool hash_generico_iguales_int(int a, int b){
+    return a == b;
+}
+
+static inline bool hash_generico_iguales_u64(uint64_t a, uint64_t b){
+    return a == b;
+}
+
+#define HASH_DEFINIR(nombre, tipo_clave, tipo_valor, fn_hash, fn_eq)                              \
+                                                                                                  \
+typedef struct nombre##_campo{                                                                    \
+    tipo_clave clave;                                                                             \
+    tipo_valor valor;                                                                             \
+    uint32_t dist;                                                                                \
+}nombre##_campo_t;                                                                                \
+                                                                                                  \
+typedef struct nombre{                                                                            \
+    nombre##_campo_t* tabla;                                                                      \
+    size_t cant;                                                                                  \
+    size_t tam;                                                                                   \
+    size_t tam_minimo;                                                                            \
+    uint64_t semilla;                                                                             \
+}nombre##_t;                                                                                      \
+                                                                                                  \
+typedef struct nombre##_iter{                                                                     \
+    const nombre##_t* hash;                                                                       \
+    size_t pos;                                                                                   \
+}nombre##_iter_t;                                                                                 \
+                                                                                                  \
+static inline size_t nombre##_posicion_ideal(tipo_clave clave, uint64_t semilla, size_t tam){     \
+    return (size_t) hash_mezclar_bits((uint64_t) fn_hash(clave) ^ semilla) & (tam - 1);          \
+}                                                                                                 \
+                                                                                                  \
+static inline void nombre##_insertar_campo(nombre##_campo_t* tabla, size_t tam, uint64_t semilla, \
+                                           nombre##_campo_t campo){                               \
+    size_t pos = nombre##_posicion_ideal(campo.clave, semilla, tam);                              \
+    campo.dist = 1;                                                                               \
+    while (tabla[pos].dist != 0){                                                                 \
+        if (tabla[pos].dist < campo.dist){                                                        \
+            nombre##_campo_t desplazado = tabla[pos];                                             \
+            tabla[pos] = campo;                                                                   \
+            campo = desplazado;                                                                   \
+        }                                                                                         \
+        pos = (pos + 1) & (tam - 1);                                                              \
+        campo.dist ++;                                                                            \
+    }                                                                                             \
+    tabla[pos] = campo;                                                                           \
+}                                                                                                 \
+                                                                                                  \
+static inline size_t nombre##_buscar_posicion(const nombre##_t* hash, tipo_clave clave){          \
+    size_t pos = nombre##_posicion_ideal(clave, hash->semilla, hash->tam);                        \
+    uint32_t dist = 1;                                                                            \
+    while (hash->tabla[pos].dist >= dist){                                                        \
+        if (fn_eq(hash->tabla[pos].clave, clave)) return pos;                                     \
+        pos = (pos + 1) & (hash->tam - 1);                                                        \
+        dist ++;                                                                                  \
+    }                                                                                             \
+    return hash->tam;                                                                             \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_redimensionar(nombre##_t* hash, size_t nuevo_tam){                    \
+    nombre##_campo_t* nueva_tabla = calloc(nuevo_tam, sizeof(nombre##_campo_t));                  \
+    if (!nueva_tabla) return false;                                                               \
+    for (size_t i = 0; i < hash->tam; i++){                                                       \
+        if (hash->tabla[i].dist != 0) nombre##_insertar_campo(nueva_tabla, nuevo_tam, hash->semilla, hash->tabla[i]); \
+    }                                                                                             \
+    free(hash->tabla);                                                                            \
+    hash->tabla = nueva_tabla;                                                                    \
+    hash->tam = nuevo_tam;                                                                        \
+    return true;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_inicializar(nombre##_t* hash, size_t capacidad){                      \
+    size_t tam = hash_tam_para_cantidad(capacidad, HASH_GENERICO_CARGA_MAX);                           \
+    hash->tabla = calloc(tam, sizeof(nombre##_campo_t));                                          \
+    if (!hash->tabla) return false;                                                               \
+    hash->cant = 0;                                                                               \
+    hash->tam = tam;                                                                              \
+    hash->tam_minimo = tam;                                                                       \
+    hash->semilla = hash_semilla_aleatoria();                                                     \
+    return true;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+static inline nombre##_t* nombre##_crear_con_capacidad(size_t capacidad){                         \
+    nombre##_t* hash = malloc(sizeof(nombre##_t));                                                \
+    if (!hash) return NULL;                                                                       \
+    if (!nombre##_inicializar(hash, capacidad)){                                                  \
+        free(hash);                                                                               \
+        return NULL;                                                                              \
+    }                                                                                             \
+    return hash;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+static inline nombre##_t* nombre##_crear(void){                                                   \
+    return nombre##_crear_con_capacidad(0);                                                       \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_guardar(nombre##_t* hash, tipo_clave clave, tipo_valor valor){        \
+    size_t pos = nombre##_buscar_posicion(hash, clave);                                           \
+    if (pos != hash->tam){                                                                        \
+        hash->tabla[pos].valor = valor;                                                           \
+        return true;                                                                              \
+    }                                                                                             \
+    if ((double) (hash->cant + 1) > (double) hash->tam * HASH_GENERICO_CARGA_MAX){                \
+        if (!nombre##_redimensionar(hash, hash->tam * 2)) return false;                           \
+    }                                                                                             \
+    nombre##_campo_t campo;                                                                       \
+    campo.clave = clave;                                                                          \
+    campo.valor = valor;                                                                          \
+    nombre##_insertar_campo(hash->tabla, hash->tam, hash->semilla, campo);                        \
+    hash->cant ++;                                                                                \
+    return true;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_obtener(const nombre##_t* hash, tipo_clave clave, tipo_valor* valor){ \
+    size_t pos = nombre##_buscar_posicion(hash, clave);                                           \
+    if (pos == hash->tam) return false;                                                           \
+    if (valor) *valor = hash->tabla[pos].valor;                                                   \
+    return true;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+static inline tipo_valor* nombre##_obtener_puntero(nombre##_t* hash, tipo_clave clave){           \
+    size_t pos = nombre##_buscar_posicion(hash, clave);                                           \
+    if (pos == hash->tam) return NULL;                                                            \
+    return &hash->tabla[pos].valor;                                                               \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_pertenece(const nombre##_t* hash, tipo_clave clave){                  \
+    return nombre##_buscar_posicion(hash, clave) != hash->tam;                                    \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_borrar(nombre##_t* hash, tipo_clave clave, tipo_valor* valor){        \
+    size_t pos = nombre##_buscar_posicion(hash, clave);                                           \
+    if (pos == hash->tam) return false;                                                           \
+    if (valor) *valor = hash->tabla[pos].valor;                                                   \
+    size_t sig = (pos + 1) & (hash->tam - 1);                                                     \
+    while (hash->tabla[sig].dist > 1){                                                            \
+        hash->tabla[pos] = hash->tabla[sig];                                                      \
+        hash->tabla[pos].dist --;                                                                 \
+        pos = sig;                                                                                \
+        sig = (sig + 1) & (hash->tam - 1);                                                        \
+    }                                                                                             \
+    hash->tabla[pos].dist = 0;                                                                    \
+    hash->cant --;                                                                                \
+    if ((double) hash->cant < (double) hash->tam * HASH_GENERICO_CARGA_MIN                        \
+        && hash->tam > hash->tam_minimo){                                                         \
+        nombre##_redimensionar(hash, hash->tam / 2);                                              \
+    }                                                                                             \
+    return true;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+static inline size_t nombre##_cantidad(const nombre##_t* hash){                                   \
+    return hash->cant;                                                                            \
+}                                                                                                 \
+                                                                                                  \
+static inline void nombre##_liberar(nombre##_t* hash){                                            \
+    free(hash->tabla);                                                                            \
+}                                                                                                 \
+                                                                                                  \
+static inline void nombre##_destruir(nombre##_t* hash){                                           \
+    nombre##_liberar(hash);                                                                       \
+    free(hash);                                                                                   \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_iter_al_final(const nombre##_iter_t* iter){                           \
+    return iter->pos >= iter->hash->tam;                                                          \
+}                                                                                                 \
+                                                                                                  \
+static inline void nombre##_iter_buscar_proximo(nombre##_iter_t* iter){                           \
+    while (!nombre##_iter_al_final(iter) && iter->hash->tabla[iter->pos].dist == 0) iter->pos ++; \
+}                                                                                                 \
+                                                                                                  \
+static inline nombre##_iter_t nombre##_iter_crear(const nombre##_t* hash){                        \
+    nombre##_iter_t iter = {hash, 0};                                                             \
+    nombre##_iter_buscar_proximo(&iter);                                                          \
+    return iter;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+static inline bool nombre##_iter_avanzar(nombre##_iter_t* iter){                                  \
+    if (nombre##_iter_al_final(iter)) return false;                                               \
+    iter->pos ++;                                                                                 \
+    nombre##_iter_buscar_proximo(iter);                                                           \
+    return !nombre##_iter_al_final(iter);                                                         \
+}                                                                                                 \
+                                                                                                  \
+static inline tipo_clave nombre##_iter_ver_actual(const nombre##_iter_t* iter){                   \
+    return iter->hash->tabla[iter->pos].clave;                                                    \
+}                                                                                                 \
+                                                                                                  \
+static inline tipo_valor nombre##_iter_ver_dato(const nombre##_iter_t* iter){                     \
+    return iter->hash->tabla[iter->pos].valor;                                                    \
+}
+
+#endif // HASH_GENERICO_H
@@ -0,0 +1,138 @@
+#ifndef HASH_INTERNO_H
+#define HASH_INTERNO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "intern.h"
+
+/* Partes de hash.c que comparten las otras tablas de hash de la biblioteca
+ * para comportarse igual que hash_t. No son parte de la interfaz pública.
+ */
+
+// Completa la política recibida (puede ser NULL) con los valores por omisión y la
+// corrige para que sea válida, como se describe en hash.h.
+hash_politica_t hash_normalizar_politica(const hash_politica_t* politica);
+
+#define HASH_CLAVE_CORTA_MAX 15 // Largo máximo de las claves que se guardan dentro del campo.
+#define HASH_LARGO_BORRADO UINT32_MAX // Largo que marca a un campo migrado o borrado de la tabla anterior.
+
+// HASH_TABLA_DEFINIR(tipo_campo) define, como funciones static inline, la tabla
+// de hash.c para claves de texto: direccionamiento abierto con Robin Hood, donde
+// 'dist' es la distancia desde la posición ideal de la clave más uno (0 indica una
+// posición vacía). Los campos guardan el hash completo y el largo de su clave, que
+// se comparan antes que la clave, y las claves de hasta HASH_CLAVE_CORTA_MAX
+// caracteres dentro del campo. tipo_campo puede agregar otros miembros (hash_t
+// agrega el dato), pero debe tener estos:
+//
+//   uint64_t hash;
+//   union{ char* larga; char corta[HASH_CLAVE_CORTA_MAX + 1]; }clave;
+//   uint32_t largo;
+//   uint32_t dist;
+//
+// Funciones definidas:
+//   size_t posicion_ideal(uint64_t hash, size_t tam);
+//   const char* clave_campo(const tipo_campo* campo);
+//   bool copiar_clave(intern_t* intern, tipo_campo* campo, const char* clave, size_t largo);
+//   void liberar_clave(const intern_t* intern, tipo_campo* campo);
+//   void insertar_campo(tipo_campo* tabla, size_t tam, tipo_campo campo);
+//   size_t buscar_posicion(const tipo_campo* tabla, size_t tam, const char* clave, uint64_t hash, size_t largo, size_t* sondeos);
+//   size_t correr_campos(tipo_campo* tabla, size_t tam, size_t pos);
+#define HASH_TABLA_DEFINIR(tipo_campo)                                                            \
+                                                                                                  \
+/* Devuelve la posición ideal de un hash en una tabla de tamaño tam (potencia de dos). */        \
+static inline size_t posicion_ideal(uint64_t hash, size_t tam){                                   \
+    return (size_t) hash & (tam - 1);                                                             \
+}                                                                                                 \
+                                                                                                  \
+/* Devuelve la clave del campo, esté guardada dentro del campo o en memoria dinámica. */         \
+static inline const char* clave_campo(const tipo_campo* campo){                                   \
+    if (campo->largo <= HASH_CLAVE_CORTA_MAX) return campo->clave.corta;                          \
+    return campo->clave.larga;                                                                    \
+}                                                                                                 \
+                                                                                                  \
+/* Copia la clave al campo: dentro de él si es corta, o en memoria dinámica si no.               \
+ * Con un intern_t, las claves largas apuntan a su copia canónica, que nunca se                  \
+ * modifica: el campo sólo la lee. Devuelve false si no se pudo pedir memoria. */                \
+static inline bool copiar_clave(intern_t* intern, tipo_campo* campo, const char* clave, size_t largo){ \
+    char* destino = campo->clave.corta;                                                           \
+    if (largo > HASH_CLAVE_CORTA_MAX && intern){                                                  \
+        campo->clave.larga = (char*) intern_agregar(intern, clave);                               \
+        campo->largo = (uint32_t) largo;                                                          \
+        return campo->clave.larga != NULL;                                                        \
+    }                                                                                             \
+    if (largo > HASH_CLAVE_CORTA_MAX){                                                            \
+        destino = malloc(largo + 1);                                                              \
+        if (!destino) return false;                                                               \
+        campo->clave.larga = destino;                                                             \
+    }                                                                                             \
+    memcpy(destino, clave, largo + 1);                                                            \
+    campo->largo = (uint32_t) largo;                                                              \
+    return true;                                                                                  \
+}                                                                                                 \
+                                                                                                  \
+/* Libera la clave del campo si estaba en memoria dinámica y no era prestada. */                 \
+static inline void liberar_clave(const intern_t* intern, tipo_campo* campo){                      \
+    if (intern) return;                                                                           \
+    if (campo->largo > HASH_CLAVE_CORTA_MAX && campo->largo != HASH_LARGO_BORRADO) free(campo->clave.larga); \
+}                                                                                                 \
+                                                                                                  \
+/* Inserta el campo en la tabla, desplazando a los campos más cercanos a su posición ideal.      \
+ * Pre: la clave no está en la tabla y hay al menos una posición vacía. */                       \
+static inline void insertar_campo(tipo_campo* tabla, size_t tam, tipo_campo campo){               \
+    size_t pos = posicion_ideal(campo.hash, tam);                                                 \
+    campo.dist = 1;                                                                               \
+    while (tabla[pos].dist != 0){                                                                 \
+        if (tabla[pos].dist < campo.dist){                                                        \
+            tipo_campo desplazado = tabla[pos];                                                   \
+            tabla[pos] = campo;                                                                   \
+            campo = desplazado;                                                                   \
+        }                                                                                         \
+        pos = (pos + 1) & (tam - 1);                                                              \
+        campo.dist ++;                                                                            \
+    }                                                                                             \
+    tabla[pos] = campo;                                                                           \
+}                                                                                                 \
+                                                                                                  \
+/* Devuelve la posición de la clave (de hash y largo dados) en la tabla, o tam si la clave       \
+ * no está. Si 'sondeos' no es NULL, le suma las posiciones que recorrió la búsqueda. */         \
+static inline size_t buscar_posicion(const tipo_campo* tabla, size_t tam, const char* clave,      \
+                                     uint64_t hash, size_t largo, size_t* sondeos){               \
+    size_t pos = posicion_ideal(hash, tam);                                                       \
+    uint32_t dist = 1;                                                                            \
+    while (tabla[pos].dist >= dist){                                                              \
+        const tipo_campo* campo = &tabla[pos];                                                    \
+        /* Las claves prestadas de un intern_t suelen ser el mismo puntero que se busca. */      \
+        const char* clave_actual = clave_campo(campo);                                            \
+        if (campo->hash == hash && campo->largo == largo                                          \
+            && (clave_actual == clave || memcmp(clave_actual, clave, largo) == 0)){               \
+            if (sondeos) *sondeos += dist;                                                        \
+            return pos;                                                                           \
+        }                                                                                         \
+        pos = (pos + 1) & (tam - 1);                                                              \
+        dist ++;                                                                                  \
+    }                                                                                             \
+    if (sondeos) *sondeos += dist;                                                                \
+    return tam;                                                                                   \
+}                                                                                                 \
+                                                                                                  \
+/* Saca de la tabla al campo de la posición recibida, cuya clave ya se liberó, y corre           \
+ * hacia atrás a los campos siguientes que estaban desplazados para que no queden                \
+ * huecos en las secuencias de búsqueda. Devuelve la posición que quedó vacía. */                \
+static inline size_t correr_campos(tipo_campo* tabla, size_t tam, size_t pos){                    \
+    size_t sig = (pos + 1) & (tam - 1);                                                           \
+    while (tabla[sig].dist > 1){                                                                  \
+        tabla[pos] = tabla[sig];                                                                  \
+        tabla[pos].dist --;                                                                       \
+        pos = sig;                                                                                \
+        sig = (sig + 1) & (tam - 1);                                                              \
+    }                                                                                             \
+    tabla[pos].largo = 0;                                                                         \
+    tabla[pos].dist = 0;                                                                          \
+    return pos;                                                                                   \
+}
+
+#endif // HASH_INTERNO_H
@@ -0,0 +1,305 @@
+#define  _POSIX_C_SOURCE 200809L
+#define  _FILE_OFFSET_BITS 64
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "hash_mmap.h"
+
+#define MAGIA "TDAHASH"
+#define VERSION 1
+#define ORDEN_BYTES 0x01020304u
+#define ALINEACION 8
+
+/* Formato del archivo:
+ *   cabecera | tabla de 'tam' ranuras | claves y datos
+ * La tabla usa direccionamiento abierto con sondeo lineal y se arma con carga
+ * de a lo sumo 1/2. Las ranuras guardan desplazamientos desde el inicio del
+ * archivo, por lo que la imagen no depende de dónde se la mapee. Una ranura con
+ * desplazamiento de clave 0 está vacía. Las claves terminan en '\0' y cada
+ * clave y cada dato empiezan en una posición múltiplo de ALINEACION.
+ */
+typedef struct cabecera{
+    char magia[8];
+    uint32_t version;
+    uint32_t orden_bytes;
+    uint64_t semilla;
+    uint64_t cant;
+    uint64_t tam;
+    uint64_t largo_archivo;
+}cabecera_t;
+
+typedef struct ranura{
+    uint64_t hash;
+    uint64_t desplazamiento_clave;
+    uint64_t desplazamiento_dato;
+    uint32_t largo_clave;
+    uint32_t largo_dato;
+}ranura_t;
+
+struct hash_mmap{
+    const char* base;
+    size_t largo;
+    const cabecera_t* cabecera;
+    const ranura_t* ranuras;
+};
+
+/*********************** Escritura ***********************/
+
+static uint64_t alinear(uint64_t desplazamiento){
+    return (desplazamiento + ALINEACION - 1) / ALINEACION * ALINEACION;
+}
+
+// Escribe 'largo' bytes seguidos del relleno necesario para llegar a la próxima alineación.
+static bool escribir_alineado(FILE* archivo, const void* bytes, size_t largo){
+    static const char relleno[ALINEACION] = {0};
+    if (largo > 0 && fwrite(bytes, 1, largo, archivo) != largo) return false;
+    size_t faltante = (size_t) (alinear(largo) - largo);
+    return faltante == 0 || fwrite(relleno, 1, faltante, archivo) == faltante;
+}
+
+// Escribe en el archivo las claves y los datos del hash, a continuación de la
+// tabla, y completa la ranura de cada clave. Cada dato se serializa y se escribe
+// antes de pasar al siguiente. Devuelve false si no pudo escribirlos.
+static bool escribir_entradas(FILE* archivo, const hash_t* hash, hash_serializar_dato_t serializar, ranura_t* ranuras, cabecera_t* cabecera){
+    hash_iter_t* iter = hash_iter_crear(hash);
+    if (!iter) return false;
+    uint64_t desplazamiento = sizeof(cabecera_t) + cabecera->tam * sizeof(ranura_t);
+    bool ok = true;
+    for (; ok && !hash_iter_al_final(iter); hash_iter_avanzar(iter)){
+        const char* clave = hash_iter_ver_actual(iter);
+        size_t largo_clave = strlen(clave);
+        size_t largo_dato = 0;
+        const void* dato = serializar ? serializar(hash_iter_ver_dato(iter), &largo_dato) : NULL;
+        if (!dato) largo_dato = 0;
+        if (largo_clave >= UINT32_MAX || largo_dato >= UINT32_MAX){
+            ok = false;
+            break;
+        }
+        uint64_t h = hash_funcion_rapida(clave, largo_clave, cabecera->semilla);
+        size_t pos = (size_t) h & (cabecera->tam - 1);
+        while (ranuras[pos].desplazamiento_clave != 0) pos = (pos + 1) & (cabecera->tam - 1);
+        ranura_t* ranura = &ranuras[pos];
+        ranura->hash = h;
+        ranura->largo_clave = (uint32_t) largo_clave;
+        ranura->largo_dato = (uint32_t) largo_dato;
+        ranura->desplazamiento_clave = desplazamiento;
+        desplazamiento += alinear(largo_clave + 1);
+        ranura->desplazamiento_dato = desplazamiento;
+        desplazamiento += alinear(largo_dato);
+        ok = escribir_alineado(archivo, clave, largo_clave + 1) && escribir_alineado(archivo, dato, largo_dato);
+    }
+    hash_iter_destruir(iter);
+    cabecera->largo_archivo = desplazamiento;
+    return ok;
+}
+
+// Escribe la imagen completa del hash en el archivo: primero deja lugar para la
+// cabecera y la tabla, escribe las entradas, y vuelve al principio a escribir
+// la cabecera y la tabla ya completas.
+static bool escribir_imagen(FILE* archivo, const hash_t* hash, hash_serializar_dato_t serializar){
+    cabecera_t cabecera = {MAGIA, VERSION, ORDEN_BYTES, hash_semilla_aleatoria(), hash_cantidad(hash), 2, 0};
+    while (cabecera.tam < 2 * cabecera.cant) cabecera.tam *= 2;
+    ranura_t* ranuras = calloc(cabecera.tam, sizeof(ranura_t));
+    if (!ranuras) return false;
+    // Las entradas empiezan después de la tabla. Con off_t de 64 bits el
+    // desplazamiento entra siempre; con off_t más chico se verifica que no se trunque.
+    uint64_t inicio_entradas = sizeof(cabecera_t) + cabecera.tam * sizeof(ranura_t);
+    off_t inicio = (off_t) inicio_entradas;
+    bool ok = inicio >= 0 && (uint64_t) inicio == inicio_entradas;
+    ok = ok && fseeko(archivo, inicio, SEEK_SET) == 0;
+    ok = ok && escribir_entradas(archivo, hash, serializar, ranuras, &cabecera);
+    ok = ok && fseeko(archivo, 0, SEEK_SET) == 0;
+    ok = ok && fwrite(&cabecera, sizeof(cabecera_t), 1, archivo) == 1;
+    ok = ok && fwrite(ranuras, sizeof(ranura_t), cabecera.tam, archivo) == cabecera.tam;
+    free(ranuras);
+    return ok;
+}
+
+// Fuerza a disco la entrada del directorio que contiene a la ruta, para que el
+// cambio de nombre sobreviva a una caída del sistema.
+static bool sincronizar_directorio(const char* ruta){
+    const char* barra = strrchr(ruta, '/');
+    char* directorio = strdup(barra ? ruta : ".");
+    if (!directorio) return false;
+    if (barra) directorio[barra == ruta ? 1 : barra - ruta] = '\0';
+    int fd = open(directorio, O_RDONLY);
+    free(directorio);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    return (close(fd) == 0) && ok;
+}
+
+bool hash_serializar(const hash_t *hash, const char *ruta, hash_serializar_dato_t serializar){
+    // La imagen se escribe en un archivo temporal del mismo directorio que
+    // reemplaza al anterior de una sola vez: los procesos que tengan mapeada la
+    // imagen anterior la siguen viendo entera.
+    size_t largo_temporal = strlen(ruta) + 32;
+    char* temporal = malloc(largo_temporal);
+    if (!temporal) return false;
+    snprintf(temporal, largo_temporal, "%s.%016llx.tmp", ruta, (unsigned long long) hash_semilla_aleatoria());
+    int fd = open(temporal, O_WRONLY | O_CREAT | O_EXCL, 0666);
+    FILE* archivo = fd >= 0 ? fdopen(fd, "wb") : NULL;
+    if (!archivo){
+        if (fd >= 0){
+            close(fd);
+            unlink(temporal);
+        }
+        free(temporal);
+        return false;
+    }
+    bool ok = escribir_imagen(archivo, hash, serializar);
+    ok = ok && fflush(archivo) == 0 && fsync(fileno(archivo)) == 0;
+    ok = (fclose(archivo) == 0) && ok;
+    ok = ok && rename(temporal, ruta) == 0;
+    if (!ok) unlink(temporal);
+    ok = ok && sincronizar_directorio(ruta);
+    free(temporal);
+    return ok;
+}
+
+/*********************** Lectura ***********************/
+
+// Devuelve true si la cabecera corresponde a una imagen válida de 'largo' bytes.
+static bool cabecera_valida(const cabecera_t* cabecera, size_t largo){
+    if (largo < sizeof(cabecera_t)) return false;
+    if (memcmp(cabecera->magia, MAGIA, sizeof(MAGIA)) != 0) return false;
+    if (cabecera->version != VERSION || cabecera->orden_bytes != ORDEN_BYTES) return false;
+    if (cabecera->tam == 0 || (cabecera->tam & (cabecera->tam - 1)) != 0 || cabecera->cant >= cabecera->tam) return false;
+    if (cabecera->tam > (largo - sizeof(cabecera_t)) / sizeof(ranura_t)) return false;
+    return cabecera->largo_archivo == largo;
+}
+
+// Devuelve true si el tramo de 'cantidad' bytes que empieza en 'desplazamiento'
+// está entre 'inicio' y 'largo'.
+static bool tramo_valido(uint64_t desplazamiento, uint64_t cantidad, uint64_t inicio, uint64_t largo){
+    return desplazamiento >= inicio && desplazamiento <= largo && cantidad <= largo - desplazamiento;
+}
+
+// Devuelve true si todas las ranuras ocupadas apuntan a claves terminadas en '\0'
+// y a datos alineados dentro del archivo, y si hay exactamente 'cant' de ellas (y
+// por lo tanto al menos una vacía, que es la que corta las búsquedas).
+// Pre: la cabecera es válida.
+static bool ranuras_validas(const char* base, size_t largo){
+    const cabecera_t* cabecera = (const cabecera_t*) base;
+    const ranura_t* ranuras = (const ranura_t*) (base + sizeof(cabecera_t));
+    uint64_t inicio = sizeof(cabecera_t) + cabecera->tam * sizeof(ranura_t);
+    uint64_t ocupadas = 0;
+    for (uint64_t i = 0; i < cabecera->tam; i++){
+        const ranura_t* ranura = &ranuras[i];
+        if (ranura->desplazamiento_clave == 0) continue;
+        ocupadas ++;
+        if (!tramo_valido(ranura->desplazamiento_clave, (uint64_t) ranura->largo_clave + 1, inicio, largo)) return false;
+        if (base[ranura->desplazamiento_clave + ranura->largo_clave] != '\0') return false;
+        if (!tramo_valido(ranura->desplazamiento_dato, ranura->largo_dato, inicio, largo)) return false;
+        if (ranura->desplazamiento_dato % ALINEACION != 0) return false;
+    }
+    return ocupadas == cabecera->cant;
+}
+
+hash_mmap_t *hash_mmap_abrir(const char *ruta){
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(cabecera_t)){
+        close(fd);
+        return NULL;
+    }
+    size_t largo = (size_t) info.st_size;
+    void* base = mmap(NULL, largo, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+
+    hash_mmap_t* hash = malloc(sizeof(hash_mmap_t));
+    if (!hash || !cabecera_valida(base, largo) || !ranuras_validas(base, largo)){
+        free(hash);
+        munmap(base, largo);
+        return NULL;
+    }
+    hash->base = base;
+    hash->largo = largo;
+    hash->cabecera = base;
+    hash->ranuras = (const ranura_t*) (hash->base + sizeof(cabecera_t));
+    return hash;
+}
+
+// Devuelve la ranura de la clave, o NULL si la clave no está.
+static const ranura_t* buscar_ranura(const hash_mmap_t* hash, const char* clave){
+    size_t largo = strlen(clave);
+    uint64_t h = hash_funcion_rapida(clave, largo, hash->cabecera->semilla);
+    size_t mascara = (size_t) hash->cabecera->tam - 1;
+    for (size_t pos = (size_t) h & mascara; hash->ranuras[pos].desplazamiento_clave != 0; pos = (pos + 1) & mascara){
+        const ranura_t* ranura = &hash->ranuras[pos];
+        if (ranura->hash == h && ranura->largo_clave == largo && memcmp(hash->base + ranura->desplazamiento_clave, clave, largo) == 0){
+            return ranura;
+        }
+    }
+    return NULL;
+}
+
+const void *hash_mmap_obtener(const hash_mmap_t *hash, const char *clave, size_t *largo){
+    const ranura_t* ranura = buscar_ranura(hash, clave);
+    if (!ranura) return NULL;
+    if (largo) *largo = ranura->largo_dato;
+    return hash->base + ranura->desplazamiento_dato;
+}
+
+bool hash_mmap_pertenece(const hash_mmap_t *hash, const char *clave){
+    return buscar_ranura(hash, clave) != NULL;
+}
+
+size_t hash_mmap_cantidad(const hash_mmap_t *hash){
+    return (size_t) hash->cabecera->cant;
+}
+
+void hash_mmap_cerrar(hash_mmap_t *hash){
+    munmap((void*) hash->base, hash->largo);
+    free(hash);
+}
+
+/*********************** Iterador ***********************/
+
+struct hash_mmap_iter{
+    const hash_mmap_t* hash;
+    size_t pos;
+};
+
+// Avanza la posición del iterador hasta la próxima ranura ocupada (o hasta el final).
+static void buscar_proxima_ranura(hash_mmap_iter_t* iter){
+    while (!hash_mmap_iter_al_final(iter) && iter->hash->ranuras[iter->pos].desplazamiento_clave == 0){
+        iter->pos ++;
+    }
+}
+
+hash_mmap_iter_t *hash_mmap_iter_crear(const hash_mmap_t *hash){
+    hash_mmap_iter_t* iter = malloc(sizeof(hash_mmap_iter_t));
+    if (!iter) return NULL;
+    iter->hash = hash;
+    iter->pos = 0;
+    buscar_proxima_ranura(iter);
+    return iter;
+}
+
+bool hash_mmap_iter_avanzar(hash_mmap_iter_t *iter){
+    if (hash_mmap_iter_al_final(iter)) return false;
+    iter->pos ++;
+    buscar_proxima_ranura(iter);
+    return !hash_mmap_iter_al_final(iter);
+}
+
+const char *hash_mmap_iter_ver_actual(const hash_mmap_iter_t *iter){
+    if (hash_mmap_iter_al_final(iter)) return NULL;
+    return iter->hash->base + iter->hash->ranuras[iter->pos].desplazamiento_clave;
+}
+
+bool hash_mmap_iter_al_final(const hash_mmap_iter_t *iter){
+    return iter->pos >= iter->hash->cabecera->tam;
+}
+
+void hash_mmap_iter_destruir(hash_mmap_iter_t *iter){
+    free(iter);
+}
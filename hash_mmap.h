@@ -0,0 +1,86 @@
+#ifndef HASH_MMAP_H
+#define HASH_MMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* Imagen de un hash en un archivo. hash_serializar escribe las claves y los
+ * datos de un hash_t en un formato que no depende de la posición en memoria,
+ * y hash_mmap_abrir lo mapea en memoria de sólo lectura y responde búsquedas
+ * e iteraciones directamente sobre el mapeo, sin reconstruir el hash. Varios
+ * procesos que abran el mismo archivo comparten sus páginas.
+ *
+ * El archivo sólo puede abrirse en una máquina con el mismo orden de bytes
+ * que la que lo escribió.
+ */
+struct hash_mmap;
+struct hash_mmap_iter;
+
+typedef struct hash_mmap hash_mmap_t;
+typedef struct hash_mmap_iter hash_mmap_iter_t;
+
+// tipo de función para serializar un dato: devuelve un puntero a los bytes que
+// lo representan y guarda su cantidad en 'largo'. Los bytes se escriben al
+// archivo antes de serializar el dato siguiente, así que la función puede
+// devolver siempre el mismo buffer.
+typedef const void *(*hash_serializar_dato_t)(const void *dato, size_t *largo);
+
+/* Escribe en el archivo de la ruta recibida la imagen del hash, usando la
+ * función recibida para serializar cada dato. Si la función es NULL, sólo se
+ * guardan las claves. Devuelve false si no pudo escribir el archivo.
+ * La imagen se escribe en un archivo temporal del mismo directorio, que se
+ * fuerza a disco y reemplaza al de la ruta de una sola vez: quien tenga mapeada
+ * la imagen anterior la sigue viendo completa hasta cerrarla.
+ * Pre: La estructura hash fue inicializada
+ * Post: El archivo contiene la imagen del hash.
+ */
+bool hash_serializar(const hash_t *hash, const char *ruta, hash_serializar_dato_t serializar);
+
+/* Mapea en memoria la imagen guardada en la ruta recibida. Devuelve NULL si
+ * no pudo abrir el archivo o si no es una imagen válida. Verifica que cada
+ * clave y cada dato estén dentro del archivo, por lo que es O(tamaño de la
+ * tabla).
+ */
+hash_mmap_t *hash_mmap_abrir(const char *ruta);
+
+/* Devuelve los bytes del dato asociado a la clave, y guarda su cantidad en
+ * 'largo' (si no es NULL). Devuelve NULL si la clave no está. Los bytes están
+ * alineados a 8 y son válidos hasta cerrar el mapeo.
+ * Pre: El mapeo fue abierto
+ */
+const void *hash_mmap_obtener(const hash_mmap_t *hash, const char *clave, size_t *largo);
+
+/* Determina si clave pertenece o no al hash mapeado.
+ * Pre: El mapeo fue abierto
+ */
+bool hash_mmap_pertenece(const hash_mmap_t *hash, const char *clave);
+
+/* Devuelve la cantidad de elementos del hash mapeado.
+ * Pre: El mapeo fue abierto
+ */
+size_t hash_mmap_cantidad(const hash_mmap_t *hash);
+
+/* Cierra el mapeo. Las claves y datos obtenidos dejan de ser válidos.
+ * Pre: El mapeo fue abierto
+ */
+void hash_mmap_cerrar(hash_mmap_t *hash);
+
+/* Iterador del hash mapeado */
+
+// Crea iterador
+hash_mmap_iter_t *hash_mmap_iter_crear(const hash_mmap_t *hash);
+
+// Avanza iterador
+bool hash_mmap_iter_avanzar(hash_mmap_iter_t *iter);
+
+// Devuelve clave actual, que apunta al mapeo y no se puede modificar.
+const char *hash_mmap_iter_ver_actual(const hash_mmap_iter_t *iter);
+
+// Comprueba si terminó la iteración
+bool hash_mmap_iter_al_final(const hash_mmap_iter_t *iter);
+
+// Destruye iterador
+void hash_mmap_iter_destruir(hash_mmap_iter_t *iter);
+
+#endif // HASH_MMAP_H
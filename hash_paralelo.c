@@ -0,0 +1,70 @@
+#define  _POSIX_C_SOURCE 200809L
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__)
+#error "hash_paralelo.c requiere C11 con <stdatomic.h> (por ejemplo, -std=c11)"
+#endif
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "hash_paralelo.h"
+
+#define PARTES_POR_HILO 8 // Partes más chicas reparten mejor el trabajo entre los hilos.
+
+// Estado compartido por los hilos de un recorrido.
+typedef struct recorrido{
+    const hash_t* hash;
+    bool (*visitar)(const char*, void*, void*);
+    void* extra;
+    size_t partes;
+    atomic_size_t proxima;  // Próxima parte sin recorrer.
+    atomic_bool cortar;     // Se activa cuando visitar devuelve false o falta memoria.
+}recorrido_t;
+
+// Recorre partes hasta que no quedan o hasta que alguno de los hilos corta el recorrido.
+static void* recorrer_partes(void* arg){
+    recorrido_t* recorrido = arg;
+    while (!atomic_load_explicit(&recorrido->cortar, memory_order_relaxed)){
+        size_t parte = atomic_fetch_add_explicit(&recorrido->proxima, 1, memory_order_relaxed);
+        if (parte >= recorrido->partes) break;
+        hash_iter_t* iter = hash_iter_rango_crear(recorrido->hash, parte, recorrido->partes);
+        if (!iter){
+            atomic_store_explicit(&recorrido->cortar, true, memory_order_relaxed);
+            break;
+        }
+        for (; !hash_iter_al_final(iter); hash_iter_avanzar(iter)){
+            if (atomic_load_explicit(&recorrido->cortar, memory_order_relaxed)) break;
+            if (!recorrido->visitar(hash_iter_ver_actual(iter), hash_iter_ver_dato(iter), recorrido->extra)){
+                atomic_store_explicit(&recorrido->cortar, true, memory_order_relaxed);
+                break;
+            }
+        }
+        hash_iter_destruir(iter);
+    }
+    return NULL;
+}
+
+bool hash_para_cada_paralelo(const hash_t *hash, size_t hilos, bool visitar(const char *, void *, void *), void *extra){
+    if (hilos == 0){
+        long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+        hilos = procesadores > 0 ? (size_t) procesadores : 1;
+    }
+    recorrido_t recorrido;
+    recorrido.hash = hash;
+    recorrido.visitar = visitar;
+    recorrido.extra = extra;
+    recorrido.partes = hilos * PARTES_POR_HILO;
+    atomic_init(&recorrido.proxima, 0);
+    atomic_init(&recorrido.cortar, false);
+
+    // Si no se pueden crear todos los hilos, los que sí se crearon (y el que
+    // llama) recorren las partes que quedan.
+    pthread_t* ids = hilos > 1 ? malloc((hilos - 1) * sizeof(pthread_t)) : NULL;
+    size_t creados = 0;
+    while (ids && creados < hilos - 1 && pthread_create(&ids[creados], NULL, recorrer_partes, &recorrido) == 0){
+        creados ++;
+    }
+    recorrer_partes(&recorrido);
+    for (size_t i = 0; i < creados; i++) pthread_join(ids[i], NULL);
+    free(ids);
+    return !atomic_load(&recorrido.cortar);
+}
@@ -0,0 +1,25 @@
+#ifndef HASH_PARALELO_H
+#define HASH_PARALELO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash.h"
+
+/* Iterador interno paralelo del hash. Divide la tabla en partes (ver
+ * hash_iter_rango_crear) que reparte entre 'hilos' hilos: cada hilo toma la
+ * próxima parte libre hasta que no quedan, de modo que los hilos que terminan
+ * antes ayudan con el resto. El hilo que llama también recorre partes.
+ * Si hilos es 0, se usa un hilo por procesador.
+ *
+ * visitar se llama desde varios hilos a la vez, una vez por cada par
+ * (clave, dato) en un orden cualquiera, y debe poder hacerlo sin pisarse con
+ * sus otras llamadas (por ejemplo, acumulando en 'extra' con atómicos o con
+ * un lock). Si devuelve false, los hilos dejan de recorrer lo antes posible.
+ *
+ * Devuelve true si se visitaron todos los elementos, y false si visitar cortó
+ * la iteración o si no hubo memoria para recorrer alguna parte.
+ * Pre: La estructura hash fue inicializada y no se modifica durante el recorrido.
+ */
+bool hash_para_cada_paralelo(const hash_t *hash, size_t hilos, bool visitar(const char *, void *, void *), void *extra);
+
+#endif // HASH_PARALELO_H
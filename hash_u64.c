@@ -0,0 +1,104 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdlib.h>
+#include "hash_generico.h"
+#include "hash_u64.h"
+
+// La tabla es la de HASH_DEFINIR (ver hash_generico.h), con los datos en la
+// tabla como void*. No hace falta guardar el hash: se recalcula mezclando los
+// bits de la clave con la semilla, que es más barato que leerlo.
+HASH_DEFINIR(tabla_u64, uint64_t, void*, hash_generico_entero, hash_generico_iguales_u64)
+
+struct hash_u64{
+    tabla_u64_t tabla;
+    hash_destruir_dato_t destruccion;
+};
+
+hash_u64_t *hash_u64_crear_con_capacidad(hash_destruir_dato_t destruir_dato, size_t capacidad){
+    hash_u64_t* hash = malloc(sizeof(hash_u64_t));
+    if (!hash) return NULL;
+    if (!tabla_u64_inicializar(&hash->tabla, capacidad)){
+        free(hash);
+        return NULL;
+    }
+    hash->destruccion = destruir_dato;
+    return hash;
+}
+
+hash_u64_t *hash_u64_crear(hash_destruir_dato_t destruir_dato){
+    return hash_u64_crear_con_capacidad(destruir_dato, 0);
+}
+
+bool hash_u64_guardar(hash_u64_t *hash, uint64_t clave, void *dato){
+    void** actual = tabla_u64_obtener_puntero(&hash->tabla, clave);
+    if (!actual) return tabla_u64_guardar(&hash->tabla, clave, dato);
+    void* dato_liberar = *actual;
+    *actual = dato;
+    if (hash->destruccion) hash->destruccion(dato_liberar);
+    return true;
+}
+
+void *hash_u64_borrar(hash_u64_t *hash, uint64_t clave){
+    void* dato = NULL;
+    tabla_u64_borrar(&hash->tabla, clave, &dato);
+    return dato;
+}
+
+void *hash_u64_obtener(const hash_u64_t *hash, uint64_t clave){
+    void* dato = NULL;
+    tabla_u64_obtener(&hash->tabla, clave, &dato);
+    return dato;
+}
+
+bool hash_u64_pertenece(const hash_u64_t *hash, uint64_t clave){
+    return tabla_u64_pertenece(&hash->tabla, clave);
+}
+
+size_t hash_u64_cantidad(const hash_u64_t *hash){
+    return tabla_u64_cantidad(&hash->tabla);
+}
+
+void hash_u64_destruir(hash_u64_t *hash){
+    if (hash->destruccion){
+        for (tabla_u64_iter_t iter = tabla_u64_iter_crear(&hash->tabla); !tabla_u64_iter_al_final(&iter); tabla_u64_iter_avanzar(&iter)){
+            hash->destruccion(tabla_u64_iter_ver_dato(&iter));
+        }
+    }
+    tabla_u64_liberar(&hash->tabla);
+    free(hash);
+}
+
+/*********************** Iterador ***********************/
+
+struct hash_u64_iter{
+    tabla_u64_iter_t iter;
+};
+
+hash_u64_iter_t *hash_u64_iter_crear(const hash_u64_t *hash){
+    hash_u64_iter_t* iter = malloc(sizeof(hash_u64_iter_t));
+    if (!iter) return NULL;
+    iter->iter = tabla_u64_iter_crear(&hash->tabla);
+    return iter;
+}
+
+bool hash_u64_iter_avanzar(hash_u64_iter_t *iter){
+    return tabla_u64_iter_avanzar(&iter->iter);
+}
+
+uint64_t hash_u64_iter_ver_actual(const hash_u64_iter_t *iter){
+    if (hash_u64_iter_al_final(iter)) return 0;
+    return tabla_u64_iter_ver_actual(&iter->iter);
+}
+
+void *hash_u64_iter_ver_dato(const hash_u64_iter_t *iter){
+    if (hash_u64_iter_al_final(iter)) return NULL;
+    return tabla_u64_iter_ver_dato(&iter->iter);
+}
+
+bool hash_u64_iter_al_final(const hash_u64_iter_t *iter){
+    return tabla_u64_iter_al_final(&iter->iter);
+}
+
+void hash_u64_iter_destruir(hash_u64_iter_t *iter){
+    free(iter);
+}
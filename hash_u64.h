@@ -0,0 +1,88 @@
+#ifndef HASH_U64_H
+#define HASH_U64_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hash.h"
+
+/* Hash con claves enteras de 64 bits. Tiene las mismas primitivas que el hash
+ * de cadenas, pero las claves se guardan en la tabla: guardar una clave nueva
+ * no pide memoria salvo al redimensionar, y buscar no calcula largos ni
+ * compara cadenas.
+ */
+struct hash_u64;
+struct hash_u64_iter;
+
+typedef struct hash_u64 hash_u64_t;
+typedef struct hash_u64_iter hash_u64_iter_t;
+
+/* Crea el hash
+ */
+hash_u64_t *hash_u64_crear(hash_destruir_dato_t destruir_dato);
+
+/* Crea el hash con lugar para 'capacidad' claves: guardarlas no redimensiona
+ * la tabla.
+ */
+hash_u64_t *hash_u64_crear_con_capacidad(hash_destruir_dato_t destruir_dato, size_t capacidad);
+
+/* Guarda un elemento en el hash, si la clave ya se encuentra en la
+ * estructura, la reemplaza. De no poder guardarlo devuelve false.
+ * Pre: La estructura hash fue inicializada
+ * Post: Se almacenó el par (clave, dato)
+ */
+bool hash_u64_guardar(hash_u64_t *hash, uint64_t clave, void *dato);
+
+/* Borra un elemento del hash y devuelve el dato asociado. Devuelve
+ * NULL si el dato no estaba.
+ * Pre: La estructura hash fue inicializada
+ * Post: El elemento fue borrado de la estructura y se lo devolvió,
+ * en el caso de que estuviera guardado.
+ */
+void *hash_u64_borrar(hash_u64_t *hash, uint64_t clave);
+
+/* Obtiene el valor de un elemento del hash, si la clave no se encuentra
+ * devuelve NULL.
+ * Pre: La estructura hash fue inicializada
+ */
+void *hash_u64_obtener(const hash_u64_t *hash, uint64_t clave);
+
+/* Determina si clave pertenece o no al hash.
+ * Pre: La estructura hash fue inicializada
+ */
+bool hash_u64_pertenece(const hash_u64_t *hash, uint64_t clave);
+
+/* Devuelve la cantidad de elementos del hash.
+ * Pre: La estructura hash fue inicializada
+ */
+size_t hash_u64_cantidad(const hash_u64_t *hash);
+
+/* Destruye la estructura liberando la memoria pedida y llamando a la función
+ * destruir para cada par (clave, dato).
+ * Pre: La estructura hash fue inicializada
+ * Post: La estructura hash fue destruida
+ */
+void hash_u64_destruir(hash_u64_t *hash);
+
+/* Iterador del hash */
+
+// Crea iterador
+hash_u64_iter_t *hash_u64_iter_crear(const hash_u64_t *hash);
+
+// Avanza iterador
+bool hash_u64_iter_avanzar(hash_u64_iter_t *iter);
+
+// Devuelve clave actual, o 0 si terminó la iteración (0 también es una clave
+// válida: usar hash_u64_iter_al_final para distinguirlos).
+uint64_t hash_u64_iter_ver_actual(const hash_u64_iter_t *iter);
+
+// Devuelve el dato de la clave actual, o NULL si terminó la iteración.
+void *hash_u64_iter_ver_dato(const hash_u64_iter_t *iter);
+
+// Comprueba si terminó la iteración
+bool hash_u64_iter_al_final(const hash_u64_iter_t *iter);
+
+// Destruye iterador
+void hash_u64_iter_destruir(hash_u64_iter_t *iter);
+
+#endif // HASH_U64_H
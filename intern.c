@@ -0,0 +1,149 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "intern.h"
+
+#define TAM_INICIAL 16 // Debe ser potencia de dos.
+#define FACTOR_CARGA_MAX 0.7
+#define TAM_BLOQUE 65536 // Bytes de cada bloque de cadenas.
+#define CADENA_GRANDE (TAM_BLOQUE / 4) // Las cadenas más largas van en un bloque propio.
+
+// Bloque de memoria donde se copian las cadenas, una detrás de otra.
+typedef struct bloque{
+    struct bloque* sig;
+    size_t usado;
+    size_t tam;
+    char datos[];
+}bloque_t;
+
+// Posición del conjunto: una posición con cadena NULL está vacía.
+typedef struct ranura{
+    uint64_t hash;
+    const char* cadena;
+    size_t largo;
+}ranura_t;
+
+// El conjunto usa direccionamiento abierto con sondeo lineal. 'bloques' es la lista
+// de bloques, empezando por el que se está llenando.
+struct intern{
+    ranura_t* ranuras;
+    size_t tam;
+    size_t cant;
+    uint64_t semilla;
+    bloque_t* bloques;
+};
+
+static bloque_t* bloque_crear(size_t tam){
+    bloque_t* bloque = malloc(sizeof(bloque_t) + tam);
+    if (!bloque) return NULL;
+    bloque->sig = NULL;
+    bloque->usado = 0;
+    bloque->tam = tam;
+    return bloque;
+}
+
+// Copia la cadena (de 'largo' caracteres más el '\0') a los bloques y devuelve la copia.
+static const char* copiar_cadena(intern_t* intern, const char* cadena, size_t largo){
+    size_t necesario = largo + 1;
+    bloque_t* bloque = intern->bloques;
+    if (necesario > CADENA_GRANDE){
+        // Va en un bloque propio detrás del actual, que se sigue llenando.
+        bloque = bloque_crear(necesario);
+        if (!bloque) return NULL;
+        bloque->sig = intern->bloques->sig;
+        intern->bloques->sig = bloque;
+    }else if (bloque->tam - bloque->usado < necesario){
+        bloque = bloque_crear(TAM_BLOQUE);
+        if (!bloque) return NULL;
+        bloque->sig = intern->bloques;
+        intern->bloques = bloque;
+    }
+    char* copia = bloque->datos + bloque->usado;
+    memcpy(copia, cadena, necesario);
+    bloque->usado += necesario;
+    return copia;
+}
+
+intern_t *intern_crear(void){
+    intern_t* intern = malloc(sizeof(intern_t));
+    if (!intern) return NULL;
+    intern->ranuras = calloc(TAM_INICIAL, sizeof(ranura_t));
+    intern->bloques = bloque_crear(TAM_BLOQUE);
+    if (!intern->ranuras || !intern->bloques){
+        free(intern->ranuras);
+        free(intern->bloques);
+        free(intern);
+        return NULL;
+    }
+    intern->tam = TAM_INICIAL;
+    intern->cant = 0;
+    intern->semilla = hash_semilla_aleatoria();
+    return intern;
+}
+
+// Devuelve la posición de la cadena, o la posición vacía donde debería ir si no está.
+static size_t buscar_ranura(const intern_t* intern, const char* cadena, uint64_t h, size_t largo){
+    size_t pos = (size_t) h & (intern->tam - 1);
+    while (intern->ranuras[pos].cadena){
+        const ranura_t* ranura = &intern->ranuras[pos];
+        if (ranura->hash == h && ranura->largo == largo && memcmp(ranura->cadena, cadena, largo) == 0) return pos;
+        pos = (pos + 1) & (intern->tam - 1);
+    }
+    return pos;
+}
+
+static bool redimensionar(intern_t* intern, size_t nuevo_tam){
+    ranura_t* nuevas = calloc(nuevo_tam, sizeof(ranura_t));
+    if (!nuevas) return false;
+    for (size_t i = 0; i < intern->tam; i++){
+        if (!intern->ranuras[i].cadena) continue;
+        size_t pos = (size_t) intern->ranuras[i].hash & (nuevo_tam - 1);
+        while (nuevas[pos].cadena) pos = (pos + 1) & (nuevo_tam - 1);
+        nuevas[pos] = intern->ranuras[i];
+    }
+    free(intern->ranuras);
+    intern->ranuras = nuevas;
+    intern->tam = nuevo_tam;
+    return true;
+}
+
+const char *intern_agregar(intern_t *intern, const char *cadena){
+    size_t largo = strlen(cadena);
+    uint64_t h = hash_funcion_rapida(cadena, largo, intern->semilla);
+    size_t pos = buscar_ranura(intern, cadena, h, largo);
+    if (intern->ranuras[pos].cadena) return intern->ranuras[pos].cadena;
+
+    if ((double) (intern->cant + 1) > (double) intern->tam * FACTOR_CARGA_MAX){
+        if (!redimensionar(intern, intern->tam * 2)) return NULL;
+        pos = buscar_ranura(intern, cadena, h, largo);
+    }
+    const char* copia = copiar_cadena(intern, cadena, largo);
+    if (!copia) return NULL;
+    intern->ranuras[pos].hash = h;
+    intern->ranuras[pos].cadena = copia;
+    intern->ranuras[pos].largo = largo;
+    intern->cant ++;
+    return copia;
+}
+
+const char *intern_buscar(const intern_t *intern, const char *cadena){
+    size_t largo = strlen(cadena);
+    uint64_t h = hash_funcion_rapida(cadena, largo, intern->semilla);
+    return intern->ranuras[buscar_ranura(intern, cadena, h, largo)].cadena;
+}
+
+size_t intern_cantidad(const intern_t *intern){
+    return intern->cant;
+}
+
+void intern_destruir(intern_t *intern){
+    while (intern->bloques){
+        bloque_t* sig = intern->bloques->sig;
+        free(intern->bloques);
+        intern->bloques = sig;
+    }
+    free(intern->ranuras);
+    free(intern);
+}
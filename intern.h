@@ -0,0 +1,47 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Conjunto de cadenas internadas: guarda una sola copia de cada cadena y
+ * devuelve siempre el mismo puntero (canónico) para cadenas iguales, por lo
+ * que dos cadenas internadas son iguales si y sólo si sus punteros lo son.
+ * Las copias se guardan una detrás de otra en bloques grandes, que se liberan
+ * todos juntos al destruir el conjunto; no se pueden quitar cadenas sueltas.
+ *
+ * Un hash o un abb creados con un intern_t toman prestadas las claves del
+ * conjunto en lugar de copiarlas, así que el conjunto debe destruirse después
+ * que ellos.
+ */
+struct intern;
+typedef struct intern intern_t;
+
+/* Crea el conjunto vacío. Devuelve NULL si no hay memoria.
+ */
+intern_t *intern_crear(void);
+
+/* Devuelve el puntero canónico de la cadena, copiándola al conjunto si no
+ * estaba. Devuelve NULL si no pudo pedir la memoria.
+ * Pre: El conjunto fue creado
+ * Post: La cadena pertenece al conjunto y el puntero devuelto es válido hasta
+ * destruirlo.
+ */
+const char *intern_agregar(intern_t *intern, const char *cadena);
+
+/* Devuelve el puntero canónico de la cadena, o NULL si no está en el conjunto.
+ * Pre: El conjunto fue creado
+ */
+const char *intern_buscar(const intern_t *intern, const char *cadena);
+
+/* Devuelve la cantidad de cadenas distintas del conjunto.
+ * Pre: El conjunto fue creado
+ */
+size_t intern_cantidad(const intern_t *intern);
+
+/* Destruye el conjunto. Los punteros devueltos dejan de ser válidos.
+ * Pre: El conjunto fue creado
+ */
+void intern_destruir(intern_t *intern);
+
+#endif // INTERN_H
@@ -0,0 +1,46 @@
+#ifndef ASIGNACIONES_H
+#define ASIGNACIONES_H
+
+#include <stddef.h>
+
+/* Cuenta los pedidos de memoria de todo el programa, incluidos los de las
+ * bibliotecas, reemplazando a malloc, calloc, realloc y free por versiones
+ * que cuentan y llaman a las de glibc. Sólo puede incluirse desde un archivo
+ * de cada programa.
+ */
+
+void *__libc_malloc(size_t tam);
+void *__libc_calloc(size_t cant, size_t tam);
+void *__libc_realloc(void *ptr, size_t tam);
+void __libc_free(void *ptr);
+
+// Pedidos (malloc, calloc y realloc) y liberaciones desde el inicio o desde el último reinicio.
+static size_t pedidos = 0;
+static size_t liberaciones = 0;
+
+static inline void reiniciar_asignaciones(void){
+    pedidos = 0;
+    liberaciones = 0;
+}
+
+void *malloc(size_t tam){
+    pedidos ++;
+    return __libc_malloc(tam);
+}
+
+void *calloc(size_t cant, size_t tam){
+    pedidos ++;
+    return __libc_calloc(cant, tam);
+}
+
+void *realloc(void *ptr, size_t tam){
+    pedidos ++;
+    return __libc_realloc(ptr, tam);
+}
+
+void free(void *ptr){
+    if (ptr) liberaciones ++;
+    __libc_free(ptr);
+}
+
+#endif // ASIGNACIONES_H
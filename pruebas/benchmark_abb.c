@@ -0,0 +1,100 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "abb.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 1000000
+#define LARGO_MAX 16
+
+// Mide guardar, obtener y borrar en abb_t insertando las claves en orden, en
+// orden inverso y en orden aleatorio. Cuenta además las comparaciones de cada
+// búsqueda: en un AVL de n nodos ninguna hace más de 1.44 log2(n + 2), sin
+// importar el orden en que se insertaron las claves.
+
+static size_t comparaciones = 0;
+
+static int comparar(const char* a, const char* b){
+    comparaciones ++;
+    return strcmp(a, b);
+}
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+// Mezcla el arreglo con Fisher-Yates.
+static void mezclar(size_t* indices, size_t n, uint64_t* estado){
+    for (size_t i = n - 1; i > 0; i--){
+        size_t j = aleatorio(estado) % (i + 1);
+        size_t aux = indices[i];
+        indices[i] = indices[j];
+        indices[j] = aux;
+    }
+}
+
+static void medir(const char* nombre, char (*claves)[LARGO_MAX], const size_t* orden, const size_t* busquedas){
+    abb_t* abb = abb_crear(comparar, NULL);
+    VERIFICAR(abb);
+    double inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(abb_guardar(abb, claves[orden[i]], claves[orden[i]]));
+    double guardar = segundos() - inicio;
+    VERIFICAR(abb_cantidad(abb) == CANT_CLAVES);
+
+    size_t max_comparaciones = 0;
+    inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        comparaciones = 0;
+        VERIFICAR(abb_obtener(abb, claves[busquedas[i]]) == claves[busquedas[i]]);
+        if (comparaciones > max_comparaciones) max_comparaciones = comparaciones;
+    }
+    double obtener = segundos() - inicio;
+    VERIFICAR((double) max_comparaciones <= 1.45 * log2(CANT_CLAVES + 2));
+
+    inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(abb_borrar(abb, claves[orden[i]]) == claves[orden[i]]);
+    double borrar = segundos() - inicio;
+    VERIFICAR(abb_cantidad(abb) == 0);
+    abb_destruir(abb);
+
+    printf("%-10s %12.1f %12.1f %12.1f %16zu\n", nombre, guardar / CANT_CLAVES * 1e9,
+           obtener / CANT_CLAVES * 1e9, borrar / CANT_CLAVES * 1e9, max_comparaciones);
+}
+
+int main(void){
+    char (*claves)[LARGO_MAX] = malloc(CANT_CLAVES * sizeof(*claves));
+    size_t* ordenado = malloc(CANT_CLAVES * sizeof(size_t));
+    size_t* inverso = malloc(CANT_CLAVES * sizeof(size_t));
+    size_t* aleatorios = malloc(CANT_CLAVES * sizeof(size_t));
+    size_t* busquedas = malloc(CANT_CLAVES * sizeof(size_t));
+    VERIFICAR(claves && ordenado && inverso && aleatorios && busquedas);
+    // Con ceros a la izquierda, el orden de los índices es el de las claves.
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        snprintf(claves[i], LARGO_MAX, "log:%010zu", i);
+        ordenado[i] = i;
+        inverso[i] = CANT_CLAVES - 1 - i;
+        aleatorios[i] = i;
+        busquedas[i] = i;
+    }
+    uint64_t estado = 88172645463325252ULL;
+    mezclar(aleatorios, CANT_CLAVES, &estado);
+    mezclar(busquedas, CANT_CLAVES, &estado);
+
+    printf("%d claves\n%-10s %12s %12s %12s %16s\n", CANT_CLAVES, "orden", "guardar ns", "obtener ns", "borrar ns", "comparaciones max");
+    medir("ordenado", claves, ordenado, busquedas);
+    medir("inverso", claves, inverso, busquedas);
+    medir("aleatorio", claves, aleatorios, busquedas);
+
+    free(busquedas);
+    free(aleatorios);
+    free(inverso);
+    free(ordenado);
+    free(claves);
+    return 0;
+}
@@ -0,0 +1,134 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hash.h"
+#include "hash_concurrente.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 100000
+#define LARGO_MAX 24
+#define SEGUNDOS_MEDICION 0.5
+#define MAX_HILOS 64
+
+// Mide operaciones por segundo según la cantidad de hilos, con un porcentaje de
+// escrituras (guardar y borrar por mitades) y el resto de lecturas. Compara a
+// hash_concurrente_t con un hash_t protegido por un único mutex.
+
+typedef struct medicion{
+    hash_concurrente_t* concurrente;
+    hash_t* hash;
+    pthread_mutex_t mutex;
+    char (*claves)[LARGO_MAX];
+    unsigned porcentaje_escrituras;
+    double fin;
+}medicion_t;
+
+typedef struct hilo{
+    medicion_t* medicion;
+    uint64_t estado;
+    size_t operaciones;
+    pthread_t hilo;
+}hilo_t;
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void* usar_concurrente(void* extra){
+    hilo_t* hilo = extra;
+    medicion_t* m = hilo->medicion;
+    while (segundos() < m->fin){
+        for (size_t i = 0; i < 1024; i++){
+            uint64_t r = aleatorio(&hilo->estado);
+            const char* clave = m->claves[r % CANT_CLAVES];
+            unsigned tirada = (unsigned) (r >> 32) % 100;
+            if (tirada >= m->porcentaje_escrituras) hash_concurrente_obtener(m->concurrente, clave);
+            else if (tirada % 2 == 0) hash_concurrente_guardar(m->concurrente, clave, (void*) clave);
+            else hash_concurrente_borrar(m->concurrente, clave);
+        }
+        hilo->operaciones += 1024;
+    }
+    return NULL;
+}
+
+static void* usar_hash_con_mutex(void* extra){
+    hilo_t* hilo = extra;
+    medicion_t* m = hilo->medicion;
+    while (segundos() < m->fin){
+        for (size_t i = 0; i < 1024; i++){
+            uint64_t r = aleatorio(&hilo->estado);
+            const char* clave = m->claves[r % CANT_CLAVES];
+            unsigned tirada = (unsigned) (r >> 32) % 100;
+            pthread_mutex_lock(&m->mutex);
+            if (tirada >= m->porcentaje_escrituras) hash_obtener(m->hash, clave);
+            else if (tirada % 2 == 0) hash_guardar(m->hash, clave, (void*) clave);
+            else hash_borrar(m->hash, clave);
+            pthread_mutex_unlock(&m->mutex);
+        }
+        hilo->operaciones += 1024;
+    }
+    return NULL;
+}
+
+// Devuelve los millones de operaciones por segundo con 'cant_hilos' hilos.
+static double medir(medicion_t* m, void* (*usar)(void*), size_t cant_hilos){
+    hilo_t hilos[MAX_HILOS];
+    m->fin = segundos() + SEGUNDOS_MEDICION;
+    double inicio = segundos();
+    for (size_t i = 0; i < cant_hilos; i++){
+        hilos[i].medicion = m;
+        hilos[i].estado = 0x9e3779b97f4a7c15ULL * (i + 1);
+        hilos[i].operaciones = 0;
+        VERIFICAR(pthread_create(&hilos[i].hilo, NULL, usar, &hilos[i]) == 0);
+    }
+    size_t operaciones = 0;
+    for (size_t i = 0; i < cant_hilos; i++){
+        pthread_join(hilos[i].hilo, NULL);
+        operaciones += hilos[i].operaciones;
+    }
+    return (double) operaciones / (segundos() - inicio) / 1e6;
+}
+
+int main(void){
+    medicion_t m;
+    m.claves = malloc(CANT_CLAVES * sizeof(*m.claves));
+    VERIFICAR(m.claves);
+    m.concurrente = hash_concurrente_crear(NULL);
+    m.hash = hash_crear(NULL);
+    VERIFICAR(m.concurrente && m.hash);
+    pthread_mutex_init(&m.mutex, NULL);
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        snprintf(m.claves[i], LARGO_MAX, "clave:%zu", i);
+        VERIFICAR(hash_concurrente_guardar(m.concurrente, m.claves[i], m.claves[i]));
+        VERIFICAR(hash_guardar(m.hash, m.claves[i], m.claves[i]));
+    }
+
+    long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_hilos = procesadores > 0 ? 2 * (size_t) procesadores : 8;
+    if (max_hilos > MAX_HILOS) max_hilos = MAX_HILOS;
+    printf("%ld procesadores, %d claves\n", procesadores, CANT_CLAVES);
+    unsigned porcentajes[] = {0, 10, 50};
+    for (size_t p = 0; p < sizeof(porcentajes) / sizeof(porcentajes[0]); p++){
+        m.porcentaje_escrituras = porcentajes[p];
+        printf("\n%u%% escrituras\n%6s %22s %22s\n", porcentajes[p], "hilos", "concurrente Mops/s", "hash + mutex Mops/s");
+        for (size_t hilos = 1; hilos <= max_hilos; hilos *= 2){
+            double concurrente = medir(&m, usar_concurrente, hilos);
+            double con_mutex = medir(&m, usar_hash_con_mutex, hilos);
+            printf("%6zu %22.2f %22.2f\n", hilos, concurrente, con_mutex);
+        }
+    }
+
+    pthread_mutex_destroy(&m.mutex);
+    hash_concurrente_destruir(m.concurrente);
+    hash_destruir(m.hash);
+    free(m.claves);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "hash_congelado.h"
+#include "pruebas.h"
+
+#define LARGO_MAX 40
+#define BUSQUEDAS 4000000
+
+// Compara hash_congelado_obtener con hash_obtener sobre el mismo conjunto de
+// claves, para tablas de distintos tamaños, con claves presentes y ausentes.
+
+static const size_t cantidades[] = {1000, 100000, 1000000, 4000000};
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+int main(void){
+    printf("%10s %12s %14s %14s %14s %14s\n", "claves", "congelar ms", "hash ns", "congelado ns", "hash aus. ns", "cong. aus. ns");
+    for (size_t c = 0; c < sizeof(cantidades) / sizeof(cantidades[0]); c++){
+        size_t cant = cantidades[c];
+        char (*claves)[LARGO_MAX] = malloc(cant * sizeof(*claves));
+        char (*ausentes)[LARGO_MAX] = malloc(cant * sizeof(*ausentes));
+        const char** orden = malloc(BUSQUEDAS * sizeof(char*));
+        const char** orden_ausentes = malloc(BUSQUEDAS * sizeof(char*));
+        VERIFICAR(claves && ausentes && orden && orden_ausentes);
+        hash_t* hash = hash_crear(NULL);
+        VERIFICAR(hash);
+        for (size_t i = 0; i < cant; i++){
+            // La mitad de las claves son cortas y la mitad largas.
+            snprintf(claves[i], LARGO_MAX, i % 2 ? "usuario/%zu/perfil" : "id%zu", i);
+            snprintf(ausentes[i], LARGO_MAX, i % 2 ? "usuario/%zu/perfil!" : "id%zu!", i);
+            VERIFICAR(hash_guardar(hash, claves[i], claves[i]));
+        }
+        uint64_t estado = 88172645463325252ULL;
+        for (size_t i = 0; i < BUSQUEDAS; i++){
+            orden[i] = claves[aleatorio(&estado) % cant];
+            orden_ausentes[i] = ausentes[aleatorio(&estado) % cant];
+        }
+
+        double inicio = segundos();
+        hash_congelado_t* congelado = hash_congelar(hash);
+        double congelar = segundos() - inicio;
+        VERIFICAR(congelado && hash_congelado_cantidad(congelado) == cant);
+
+        size_t encontradas = 0;
+        inicio = segundos();
+        for (size_t i = 0; i < BUSQUEDAS; i++) encontradas += hash_obtener(hash, orden[i]) == orden[i];
+        double tiempo_hash = segundos() - inicio;
+        inicio = segundos();
+        for (size_t i = 0; i < BUSQUEDAS; i++) encontradas += hash_congelado_obtener(congelado, orden[i]) == orden[i];
+        double tiempo_congelado = segundos() - inicio;
+        VERIFICAR(encontradas == 2 * BUSQUEDAS);
+
+        inicio = segundos();
+        for (size_t i = 0; i < BUSQUEDAS; i++) encontradas += hash_pertenece(hash, orden_ausentes[i]);
+        double ausentes_hash = segundos() - inicio;
+        inicio = segundos();
+        for (size_t i = 0; i < BUSQUEDAS; i++) encontradas += hash_congelado_pertenece(congelado, orden_ausentes[i]);
+        double ausentes_congelado = segundos() - inicio;
+        VERIFICAR(encontradas == 2 * BUSQUEDAS);
+
+        printf("%10zu %12.1f %14.1f %14.1f %14.1f %14.1f\n", cant, congelar * 1e3,
+               tiempo_hash / BUSQUEDAS * 1e9, tiempo_congelado / BUSQUEDAS * 1e9,
+               ausentes_hash / BUSQUEDAS * 1e9, ausentes_congelado / BUSQUEDAS * 1e9);
+
+        hash_congelado_destruir(congelado);
+        hash_destruir(hash);
+        free(orden_ausentes);
+        free(orden);
+        free(ausentes);
+        free(claves);
+    }
+    return 0;
+}
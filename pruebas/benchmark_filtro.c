@@ -0,0 +1,95 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "abb.h"
+#include "bloom.h"
+#include "hash.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 1000000
+#define BUSQUEDAS 4000000
+#define LARGO_MAX 32
+#define PORCENTAJE_AUSENTES 90
+
+// Mide búsquedas en hash_t y abb_t con y sin filtro de Bloom, para distintas tasas
+// de falsos positivos, con una carga en la que la mayoría de las claves buscadas
+// están ausentes. Informa también la tasa de falsos positivos observada.
+
+static const double tasas[] = {0, 0.1, 0.01, 0.001};
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static int comparar(const char* a, const char* b){
+    return strcmp(a, b);
+}
+
+int main(void){
+    char (*claves)[LARGO_MAX] = malloc(CANT_CLAVES * sizeof(*claves));
+    char (*ausentes)[LARGO_MAX] = malloc(CANT_CLAVES * sizeof(*ausentes));
+    const char** orden = malloc(BUSQUEDAS * sizeof(char*));
+    VERIFICAR(claves && ausentes && orden);
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        snprintf(claves[i], LARGO_MAX, "usuario:%zu", i);
+        snprintf(ausentes[i], LARGO_MAX, "usuario:%zu", i + CANT_CLAVES);
+    }
+    uint64_t estado = 88172645463325252ULL;
+    size_t esperadas = 0;
+    for (size_t i = 0; i < BUSQUEDAS; i++){
+        size_t indice = aleatorio(&estado) % CANT_CLAVES;
+        bool ausente = aleatorio(&estado) % 100 < PORCENTAJE_AUSENTES;
+        orden[i] = ausente ? ausentes[indice] : claves[indice];
+        esperadas += !ausente;
+    }
+
+    printf("%d claves, %d búsquedas (%d%% ausentes)\n", CANT_CLAVES, BUSQUEDAS, PORCENTAJE_AUSENTES);
+    printf("%8s %12s %12s %14s\n", "tasa", "hash ns", "abb ns", "fp observada");
+    for (size_t t = 0; t < sizeof(tasas) / sizeof(tasas[0]); t++){
+        hash_opciones_t opciones_hash = {.tasa_falsos_positivos = tasas[t]};
+        abb_opciones_t opciones_abb = {.tasa_falsos_positivos = tasas[t]};
+        hash_t* hash = hash_crear_con_opciones(NULL, &opciones_hash);
+        abb_t* abb = abb_crear_con_opciones(comparar, NULL, &opciones_abb);
+        VERIFICAR(hash && abb);
+        for (size_t i = 0; i < CANT_CLAVES; i++){
+            VERIFICAR(hash_guardar(hash, claves[i], claves[i]));
+            VERIFICAR(abb_guardar(abb, claves[i], claves[i]));
+        }
+
+        size_t encontradas = 0;
+        double inicio = segundos();
+        for (size_t i = 0; i < BUSQUEDAS; i++) encontradas += hash_obtener(hash, orden[i]) != NULL;
+        double tiempo_hash = segundos() - inicio;
+        inicio = segundos();
+        for (size_t i = 0; i < BUSQUEDAS; i++) encontradas += abb_obtener(abb, orden[i]) != NULL;
+        double tiempo_abb = segundos() - inicio;
+        VERIFICAR(encontradas == 2 * esperadas);
+
+        // Tasa de falsos positivos de un filtro como el que arman hash_t y abb_t.
+        double observada = 0;
+        if (tasas[t] > 0){
+            bloom_t* bloom = bloom_crear(CANT_CLAVES, tasas[t]);
+            VERIFICAR(bloom);
+            for (size_t i = 0; i < CANT_CLAVES; i++) bloom_agregar(bloom, claves[i]);
+            size_t falsos = 0;
+            for (size_t i = 0; i < CANT_CLAVES; i++) falsos += bloom_contiene(bloom, ausentes[i]);
+            observada = (double) falsos / CANT_CLAVES;
+            bloom_destruir(bloom);
+        }
+        printf("%8g %12.1f %12.1f %14.4f\n", tasas[t], tiempo_hash / BUSQUEDAS * 1e9,
+               tiempo_abb / BUSQUEDAS * 1e9, observada);
+
+        abb_destruir(abb);
+        hash_destruir(hash);
+    }
+
+    free(orden);
+    free(ausentes);
+    free(claves);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "pruebas.h"
+
+#define BYTES_POR_MEDICION (64 * 1024 * 1024) // Bytes hasheados en cada medición de una función.
+#define CANT_CLAVES 200000 // Claves de la medición sobre el hash.
+#define BUSQUEDAS 2000000
+
+static const size_t largos[] = {4, 8, 16, 32, 64, 256, 1024, 4096};
+
+// Devuelve los GB/s que procesa la función con claves del largo dado.
+static double medir_funcion(hash_funcion_t funcion, const char* bytes, size_t largo){
+    size_t repeticiones = BYTES_POR_MEDICION / largo;
+    uint64_t acumulado = 0;
+    double inicio = segundos();
+    for (size_t i = 0; i < repeticiones; i++){
+        // El resultado anterior entra en la semilla para que las llamadas no se superpongan.
+        acumulado += funcion(bytes, largo, acumulado | 1);
+    }
+    double transcurrido = segundos() - inicio;
+    if (acumulado == 42) printf(" ");
+    return (double) BYTES_POR_MEDICION / transcurrido / 1e9;
+}
+
+// Devuelve los nanosegundos por hash_obtener en un hash con la función y el largo de clave dados.
+static double medir_hash(hash_funcion_t funcion, size_t largo){
+    char* claves = malloc(CANT_CLAVES * (largo + 1));
+    VERIFICAR(claves);
+    hash_t* hash = hash_crear_con_funcion(NULL, funcion, 0);
+    VERIFICAR(hash);
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        char* clave = claves + i * (largo + 1);
+        memset(clave, 'k', largo);
+        char numero[32];
+        int digitos = snprintf(numero, sizeof(numero), "%zu", i);
+        memcpy(clave + largo - (size_t) digitos, numero, (size_t) digitos);
+        clave[largo] = '\0';
+        VERIFICAR(hash_guardar(hash, clave, clave));
+    }
+    size_t encontradas = 0;
+    double inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++){
+        size_t indice = (i * 7919) % CANT_CLAVES;
+        encontradas += hash_obtener(hash, claves + indice * (largo + 1)) != NULL;
+    }
+    double transcurrido = segundos() - inicio;
+    VERIFICAR(encontradas == BUSQUEDAS);
+    hash_destruir(hash);
+    free(claves);
+    return transcurrido / BUSQUEDAS * 1e9;
+}
+
+int main(void){
+    char* bytes = malloc(largos[sizeof(largos) / sizeof(largos[0]) - 1]);
+    VERIFICAR(bytes);
+    for (size_t i = 0; i < largos[sizeof(largos) / sizeof(largos[0]) - 1]; i++) bytes[i] = (char) ('a' + i % 26);
+
+    printf("%8s %14s %14s %16s %16s\n", "largo", "djb2 GB/s", "rápida GB/s", "djb2 ns/obtener", "rápida ns/obtener");
+    for (size_t i = 0; i < sizeof(largos) / sizeof(largos[0]); i++){
+        size_t largo = largos[i];
+        double djb2 = medir_funcion(hash_funcion_djb2, bytes, largo);
+        double rapida = medir_funcion(hash_funcion_rapida, bytes, largo);
+        // Las claves de más de 256 bytes hacen que el hash ocupe demasiada memoria.
+        if (largo >= 8 && largo <= 256){
+            printf("%8zu %14.2f %14.2f %16.1f %16.1f\n", largo, djb2, rapida,
+                   medir_hash(hash_funcion_djb2, largo), medir_hash(hash_funcion_rapida, largo));
+        }else{
+            printf("%8zu %14.2f %14.2f %16s %16s\n", largo, djb2, rapida, "-", "-");
+        }
+    }
+    free(bytes);
+    return 0;
+}
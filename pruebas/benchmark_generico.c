@@ -0,0 +1,141 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "hash_generico.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 1000000
+#define BUSQUEDAS 4000000
+#define LARGO_MAX 16
+
+// Compara hashes de HASH_DEFINIR con valores int y con un struct chico contra
+// hash_t, que necesita las claves como cadenas y los valores en memoria aparte.
+
+typedef struct punto{
+    float x, y, z;
+    int id;
+}punto_t;
+
+static inline uint64_t hash_int(int clave){
+    return (uint64_t) (unsigned) clave;
+}
+
+HASH_DEFINIR(hash_int_int, int, int, hash_int, hash_generico_iguales_int)
+HASH_DEFINIR(hash_int_punto, int, punto_t, hash_int, hash_generico_iguales_int)
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void informar(const char* nombre, double guardar, double obtener, double destruir){
+    printf("%-22s %14.1f %14.1f %14.1f\n", nombre, guardar / CANT_CLAVES * 1e9, obtener / BUSQUEDAS * 1e9, destruir * 1e3);
+}
+
+static punto_t punto_de(int i){
+    punto_t punto = {(float) i, (float) i * 2, (float) i * 3, i};
+    return punto;
+}
+
+int main(void){
+    int* orden = malloc(BUSQUEDAS * sizeof(int));
+    char (*claves)[LARGO_MAX] = malloc(CANT_CLAVES * sizeof(*claves));
+    VERIFICAR(orden && claves);
+    uint64_t estado = 88172645463325252ULL;
+    for (size_t i = 0; i < BUSQUEDAS; i++) orden[i] = (int) (aleatorio(&estado) % CANT_CLAVES);
+
+    printf("%d claves, %d búsquedas\n", CANT_CLAVES, BUSQUEDAS);
+    printf("%-22s %14s %14s %14s\n", "", "guardar ns", "obtener ns", "destruir ms");
+
+    // int -> int
+    double inicio = segundos();
+    hash_int_int_t* enteros = hash_int_int_crear();
+    VERIFICAR(enteros);
+    for (int i = 0; i < CANT_CLAVES; i++) VERIFICAR(hash_int_int_guardar(enteros, i, i * 2));
+    double guardar = segundos() - inicio;
+    long long suma = 0;
+    inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++){
+        int valor;
+        if (hash_int_int_obtener(enteros, orden[i], &valor)) suma += valor;
+    }
+    double obtener = segundos() - inicio;
+    inicio = segundos();
+    hash_int_int_destruir(enteros);
+    informar("HASH_DEFINIR int", guardar, obtener, segundos() - inicio);
+
+    // hash_t con el int en memoria aparte. Guardar incluye formatear la clave;
+    // las búsquedas usan las claves ya formateadas.
+    long long suma_hash = 0;
+    inicio = segundos();
+    hash_t* hash = hash_crear(free);
+    VERIFICAR(hash);
+    for (int i = 0; i < CANT_CLAVES; i++){
+        int* valor = malloc(sizeof(int));
+        VERIFICAR(valor);
+        *valor = i * 2;
+        snprintf(claves[i], LARGO_MAX, "%d", i);
+        VERIFICAR(hash_guardar(hash, claves[i], valor));
+    }
+    guardar = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++){
+        const int* valor = hash_obtener(hash, claves[orden[i]]);
+        if (valor) suma_hash += *valor;
+    }
+    obtener = segundos() - inicio;
+    inicio = segundos();
+    hash_destruir(hash);
+    informar("hash_t int", guardar, obtener, segundos() - inicio);
+    VERIFICAR(suma == suma_hash);
+
+    // int -> punto_t
+    suma = 0;
+    inicio = segundos();
+    hash_int_punto_t* puntos = hash_int_punto_crear();
+    VERIFICAR(puntos);
+    for (int i = 0; i < CANT_CLAVES; i++) VERIFICAR(hash_int_punto_guardar(puntos, i, punto_de(i)));
+    guardar = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++){
+        const punto_t* punto = hash_int_punto_obtener_puntero(puntos, orden[i]);
+        if (punto) suma += punto->id;
+    }
+    obtener = segundos() - inicio;
+    inicio = segundos();
+    hash_int_punto_destruir(puntos);
+    informar("HASH_DEFINIR punto_t", guardar, obtener, segundos() - inicio);
+
+    // hash_t con el punto_t en memoria aparte.
+    suma_hash = 0;
+    inicio = segundos();
+    hash = hash_crear(free);
+    VERIFICAR(hash);
+    for (int i = 0; i < CANT_CLAVES; i++){
+        punto_t* punto = malloc(sizeof(punto_t));
+        VERIFICAR(punto);
+        *punto = punto_de(i);
+        snprintf(claves[i], LARGO_MAX, "%d", i);
+        VERIFICAR(hash_guardar(hash, claves[i], punto));
+    }
+    guardar = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++){
+        const punto_t* punto = hash_obtener(hash, claves[orden[i]]);
+        if (punto) suma_hash += punto->id;
+    }
+    obtener = segundos() - inicio;
+    inicio = segundos();
+    hash_destruir(hash);
+    informar("hash_t punto_t", guardar, obtener, segundos() - inicio);
+    VERIFICAR(suma == suma_hash);
+
+    free(claves);
+    free(orden);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES_OMISION 4000000 // Tabla de 8M posiciones de 40 bytes: más que la caché de último nivel.
+#define LARGO_MAX 24
+#define TAM_PEDIDO 256 // Claves por llamado a las primitivas por lotes.
+
+// Compara las primitivas por lotes con un ciclo de primitivas sueltas sobre una
+// tabla más grande que la caché, buscando las claves en orden aleatorio.
+// Uso: benchmark_lotes [cantidad de claves]
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+int main(int argc, char* argv[]){
+    size_t cant = argc > 1 ? strtoul(argv[1], NULL, 10) : CANT_CLAVES_OMISION;
+    VERIFICAR(cant >= TAM_PEDIDO);
+    char (*claves)[LARGO_MAX] = malloc(cant * sizeof(*claves));
+    const char** orden = malloc(cant * sizeof(char*));
+    void** datos = malloc(cant * sizeof(void*));
+    VERIFICAR(claves && orden && datos);
+    hash_t* hash = hash_crear_con_capacidad(NULL, cant);
+    VERIFICAR(hash);
+    for (size_t i = 0; i < cant; i++){
+        snprintf(claves[i], LARGO_MAX, "k%zu", i);
+        VERIFICAR(hash_guardar(hash, claves[i], claves[i]));
+    }
+    // Mitad de las búsquedas son de claves presentes y mitad de ausentes.
+    uint64_t estado = 88172645463325252ULL;
+    char (*ausentes)[LARGO_MAX] = malloc(cant * sizeof(*ausentes));
+    VERIFICAR(ausentes);
+    for (size_t i = 0; i < cant; i++){
+        size_t indice = aleatorio(&estado) % cant;
+        if (i % 2 == 0){
+            orden[i] = claves[indice];
+        }else{
+            snprintf(ausentes[i], LARGO_MAX, "x%zu", indice);
+            orden[i] = ausentes[i];
+        }
+    }
+    hash_estadisticas_t estadisticas = hash_estadisticas(hash);
+    printf("%zu claves, tabla de %zu posiciones (%zu MB)\n", cant, estadisticas.tam, estadisticas.tam * 40 / (1024 * 1024));
+
+    double inicio = segundos();
+    size_t encontradas = 0;
+    for (size_t i = 0; i < cant; i++) encontradas += hash_obtener(hash, orden[i]) != NULL;
+    double sueltas = segundos() - inicio;
+
+    inicio = segundos();
+    for (size_t i = 0; i < cant; i += TAM_PEDIDO){
+        size_t n = cant - i < TAM_PEDIDO ? cant - i : TAM_PEDIDO;
+        hash_obtener_lote(hash, orden + i, n, datos + i);
+    }
+    double lotes = segundos() - inicio;
+    size_t encontradas_lote = 0;
+    for (size_t i = 0; i < cant; i++){
+        VERIFICAR(datos[i] == hash_obtener(hash, orden[i]));
+        encontradas_lote += datos[i] != NULL;
+    }
+    VERIFICAR(encontradas == encontradas_lote);
+    printf("obtener: %.1f ns/clave sueltas, %.1f ns/clave en lotes (%.2fx)\n",
+           sueltas / (double) cant * 1e9, lotes / (double) cant * 1e9, sueltas / lotes);
+
+    // Borrar y volver a guardar la mitad de las claves presentes, sueltas y en lotes.
+    size_t mitad = cant / 2;
+    const char** presentes = malloc(mitad * sizeof(char*));
+    VERIFICAR(presentes);
+    for (size_t i = 0; i < mitad; i++){
+        presentes[i] = claves[(i * 7) % cant];
+        datos[i] = claves[(i * 7) % cant];
+    }
+    inicio = segundos();
+    for (size_t i = 0; i < mitad; i++) hash_borrar(hash, presentes[i]);
+    for (size_t i = 0; i < mitad; i++) hash_guardar(hash, presentes[i], (void*) presentes[i]);
+    double escrituras_sueltas = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < mitad; i += TAM_PEDIDO){
+        size_t n = mitad - i < TAM_PEDIDO ? mitad - i : TAM_PEDIDO;
+        hash_borrar_lote(hash, presentes + i, n, NULL);
+    }
+    for (size_t i = 0; i < mitad; i += TAM_PEDIDO){
+        size_t n = mitad - i < TAM_PEDIDO ? mitad - i : TAM_PEDIDO;
+        VERIFICAR(hash_guardar_lote(hash, presentes + i, datos + i, n));
+    }
+    double escrituras_lotes = segundos() - inicio;
+    VERIFICAR(hash_cantidad(hash) == cant);
+    printf("borrar + guardar: %.1f ns/clave sueltas, %.1f ns/clave en lotes (%.2fx)\n",
+           escrituras_sueltas / (double) (2 * mitad) * 1e9, escrituras_lotes / (double) (2 * mitad) * 1e9,
+           escrituras_sueltas / escrituras_lotes);
+
+    hash_destruir(hash);
+    free(presentes);
+    free(ausentes);
+    free(datos);
+    free(orden);
+    free(claves);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hash.h"
+#include "hash_paralelo.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 2000000
+#define LARGO_MAX 32
+#define VUELTAS 8 // Hashes por clave visitada, para que visitar haga algo de trabajo.
+#define MAX_HILOS 16
+
+// Mide hash_para_cada_paralelo según la cantidad de hilos y su aceleración
+// respecto de un solo hilo. Cada visita hashea la clave VUELTAS veces y suma
+// el dato; los hilos acumulan en 'extra' sólo de vez en cuando, para que el
+// mutex no limite la aceleración.
+
+typedef struct acumulado{
+    pthread_mutex_t mutex;
+    uint64_t suma;
+    uint64_t mezcla;
+}acumulado_t;
+
+static bool visitar(const char* clave, void* dato, void* extra){
+    acumulado_t* acumulado = extra;
+    size_t largo = strlen(clave);
+    uint64_t h = 0;
+    for (size_t i = 0; i < VUELTAS; i++) h = hash_funcion_rapida(clave, largo, h + 1);
+    // Acumular algunos hashes evita que el compilador descarte el cálculo.
+    if ((h & 0x3ff) == 0){
+        pthread_mutex_lock(&acumulado->mutex);
+        acumulado->mezcla ^= h;
+        pthread_mutex_unlock(&acumulado->mutex);
+    }
+    // La suma de los datos verifica que se visitó cada clave una vez.
+    if ((uintptr_t) dato % 1024 == 0){
+        pthread_mutex_lock(&acumulado->mutex);
+        acumulado->suma += (uintptr_t) dato;
+        pthread_mutex_unlock(&acumulado->mutex);
+    }
+    return true;
+}
+
+int main(void){
+    hash_t* hash = hash_crear_con_capacidad(NULL, CANT_CLAVES);
+    VERIFICAR(hash);
+    char clave[LARGO_MAX];
+    uint64_t suma_esperada = 0;
+    for (size_t i = 1; i <= CANT_CLAVES; i++){
+        snprintf(clave, LARGO_MAX, "registro:%zu", i);
+        VERIFICAR(hash_guardar(hash, clave, (void*) (uintptr_t) i));
+        if (i % 1024 == 0) suma_esperada += i;
+    }
+
+    long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("%d claves, %ld procesadores\n%-8s %12s %14s\n", CANT_CLAVES, procesadores, "hilos", "tiempo ms", "aceleración");
+    double base = 0;
+    for (size_t hilos = 1; hilos <= MAX_HILOS; hilos *= 2){
+        acumulado_t acumulado = {.suma = 0, .mezcla = 0};
+        pthread_mutex_init(&acumulado.mutex, NULL);
+        double inicio = segundos();
+        VERIFICAR(hash_para_cada_paralelo(hash, hilos, visitar, &acumulado));
+        double tiempo = segundos() - inicio;
+        VERIFICAR(acumulado.suma == suma_esperada);
+        pthread_mutex_destroy(&acumulado.mutex);
+        if (hilos == 1) base = tiempo;
+        printf("%-8zu %12.1f %14.2f\n", hilos, tiempo * 1e3, base / tiempo);
+    }
+
+    hash_destruir(hash);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "hash_u64.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 1000000
+#define BUSQUEDAS 4000000
+#define LARGO_MAX 24
+
+// Compara hash_u64_t con hash_t usando como clave el entero formateado con
+// snprintf, que es lo que hace falta para guardar enteros en hash_t. Para
+// hash_t se mide formateando la clave en cada operación y con las claves ya
+// formateadas de antemano.
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void informar(const char* nombre, double guardar, double obtener, double borrar){
+    printf("%-26s %12.1f %12.1f %12.1f\n", nombre, guardar / CANT_CLAVES * 1e9, obtener / BUSQUEDAS * 1e9, borrar / CANT_CLAVES * 1e9);
+}
+
+static void medir_u64(const uint64_t* claves, const size_t* orden, uintptr_t* suma){
+    hash_u64_t* hash = hash_u64_crear(NULL);
+    VERIFICAR(hash);
+    double inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(hash_u64_guardar(hash, claves[i], (void*) (uintptr_t) (i + 1)));
+    double guardar = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++) *suma += (uintptr_t) hash_u64_obtener(hash, claves[orden[i]]);
+    double obtener = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(hash_u64_borrar(hash, claves[i]));
+    double borrar = segundos() - inicio;
+    hash_u64_destruir(hash);
+    informar("hash_u64_t", guardar, obtener, borrar);
+}
+
+static void medir_formateando(const uint64_t* claves, const size_t* orden, uintptr_t* suma){
+    hash_t* hash = hash_crear(NULL);
+    VERIFICAR(hash);
+    char clave[LARGO_MAX];
+    double inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        snprintf(clave, LARGO_MAX, "%" PRIu64, claves[i]);
+        VERIFICAR(hash_guardar(hash, clave, (void*) (uintptr_t) (i + 1)));
+    }
+    double guardar = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++){
+        snprintf(clave, LARGO_MAX, "%" PRIu64, claves[orden[i]]);
+        *suma += (uintptr_t) hash_obtener(hash, clave);
+    }
+    double obtener = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        snprintf(clave, LARGO_MAX, "%" PRIu64, claves[i]);
+        VERIFICAR(hash_borrar(hash, clave));
+    }
+    double borrar = segundos() - inicio;
+    hash_destruir(hash);
+    informar("hash_t formateando", guardar, obtener, borrar);
+}
+
+static void medir_formateadas(char (*formateadas)[LARGO_MAX], const size_t* orden, uintptr_t* suma){
+    hash_t* hash = hash_crear(NULL);
+    VERIFICAR(hash);
+    double inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(hash_guardar(hash, formateadas[i], (void*) (uintptr_t) (i + 1)));
+    double guardar = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < BUSQUEDAS; i++) *suma += (uintptr_t) hash_obtener(hash, formateadas[orden[i]]);
+    double obtener = segundos() - inicio;
+    inicio = segundos();
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(hash_borrar(hash, formateadas[i]));
+    double borrar = segundos() - inicio;
+    hash_destruir(hash);
+    informar("hash_t ya formateadas", guardar, obtener, borrar);
+}
+
+int main(void){
+    uint64_t* claves = malloc(CANT_CLAVES * sizeof(uint64_t));
+    size_t* orden = malloc(BUSQUEDAS * sizeof(size_t));
+    char (*formateadas)[LARGO_MAX] = malloc(CANT_CLAVES * sizeof(*formateadas));
+    VERIFICAR(claves && orden && formateadas);
+    uint64_t estado = 88172645463325252ULL;
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        claves[i] = aleatorio(&estado);
+        snprintf(formateadas[i], LARGO_MAX, "%" PRIu64, claves[i]);
+    }
+    for (size_t i = 0; i < BUSQUEDAS; i++) orden[i] = aleatorio(&estado) % CANT_CLAVES;
+
+    printf("%d claves, %d búsquedas\n", CANT_CLAVES, BUSQUEDAS);
+    printf("%-26s %12s %12s %12s\n", "", "guardar ns", "obtener ns", "borrar ns");
+    uintptr_t sumas[3] = {0, 0, 0};
+    medir_u64(claves, orden, &sumas[0]);
+    medir_formateando(claves, orden, &sumas[1]);
+    medir_formateadas(formateadas, orden, &sumas[2]);
+    VERIFICAR(sumas[0] == sumas[1] && sumas[1] == sumas[2]);
+
+    free(formateadas);
+    free(orden);
+    free(claves);
+    return 0;
+}
@@ -0,0 +1,114 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "abb.h"
+#include "pruebas.h"
+
+#define UNIVERSO 3000 // Claves posibles.
+#define OPERACIONES 30000
+#define CADA 1000 // Operaciones entre verificaciones completas.
+#define CONSULTAS_ENTRE 300
+#define LARGO_MAX 16
+
+// Compara abb_seleccionar, abb_rango y abb_contar_entre con un arreglo ordenado
+// mientras se agregan y borran claves al azar. La clave i es "c" seguida de i
+// con ceros a la izquierda, así que el orden de los índices es el de las claves;
+// la sonda i (i seguido de "5") no pertenece al abb y queda entre las claves i
+// e i + 1.
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void clave_de(char* clave, size_t i){
+    snprintf(clave, LARGO_MAX, "c%05zu", i);
+}
+
+static void sonda_de(char* sonda, size_t i){
+    snprintf(sonda, LARGO_MAX, "c%05zu5", i);
+}
+
+// Verifica las tres primitivas contra 'esta'. menores[i] es la cantidad de
+// claves presentes con índice menor que i, y ordenadas las presentes en orden.
+static void verificar(const abb_t* abb, const bool* esta, uint64_t* estado){
+    static size_t menores[UNIVERSO + 1];
+    static size_t ordenadas[UNIVERSO];
+    size_t cant = 0;
+    for (size_t i = 0; i < UNIVERSO; i++){
+        menores[i] = cant;
+        if (esta[i]) ordenadas[cant++] = i;
+    }
+    menores[UNIVERSO] = cant;
+    VERIFICAR(abb_cantidad((abb_t*) abb) == cant);
+
+    char clave[LARGO_MAX], otra[LARGO_MAX];
+    for (size_t k = 0; k < cant; k++){
+        clave_de(clave, ordenadas[k]);
+        VERIFICAR(strcmp(abb_seleccionar(abb, k), clave) == 0);
+    }
+    VERIFICAR(abb_seleccionar(abb, cant) == NULL);
+    VERIFICAR(abb_seleccionar(abb, SIZE_MAX) == NULL);
+
+    for (size_t i = 0; i < UNIVERSO; i++){
+        clave_de(clave, i);
+        VERIFICAR(abb_rango(abb, clave) == menores[i]);
+        sonda_de(clave, i);
+        VERIFICAR(abb_rango(abb, clave) == menores[i + 1]);
+    }
+    VERIFICAR(abb_rango(abb, "a") == 0 && abb_rango(abb, "d") == cant);
+
+    // Extremos abiertos.
+    VERIFICAR(abb_contar_entre(abb, NULL, NULL) == cant);
+    for (size_t i = 0; i < UNIVERSO; i += 97){
+        clave_de(clave, i);
+        VERIFICAR(abb_contar_entre(abb, clave, NULL) == cant - menores[i]);
+        VERIFICAR(abb_contar_entre(abb, NULL, clave) == menores[i + 1]);
+    }
+    // Extremos al azar, en claves o en sondas, incluidos los invertidos.
+    for (size_t c = 0; c < CONSULTAS_ENTRE; c++){
+        size_t desde = aleatorio(estado) % UNIVERSO, hasta = aleatorio(estado) % UNIVERSO;
+        bool desde_sonda = aleatorio(estado) % 2, hasta_sonda = aleatorio(estado) % 2;
+        if (desde_sonda) sonda_de(clave, desde);
+        else clave_de(clave, desde);
+        if (hasta_sonda) sonda_de(otra, hasta);
+        else clave_de(otra, hasta);
+        // Claves presentes con índice en [primera, ultima + 1).
+        size_t primera = desde + (desde_sonda ? 1 : 0), fin = hasta + 1;
+        size_t esperado = fin > primera ? menores[fin] - menores[primera] : 0;
+        VERIFICAR(abb_contar_entre(abb, clave, otra) == esperado);
+    }
+}
+
+int main(void){
+    abb_t* abb = abb_crear(strcmp, NULL);
+    bool* esta = calloc(UNIVERSO, sizeof(bool));
+    VERIFICAR(abb && esta);
+    uint64_t estado = 88172645463325252ULL;
+    verificar(abb, esta, &estado);
+
+    char clave[LARGO_MAX];
+    for (size_t op = 1; op <= OPERACIONES; op++){
+        // Al principio se agrega más de lo que se borra, y al final al revés.
+        size_t i = aleatorio(&estado) % UNIVERSO;
+        bool agregar = aleatorio(&estado) % 100 < (op < OPERACIONES / 2 ? 70 : 30);
+        clave_de(clave, i);
+        if (agregar){
+            VERIFICAR(abb_guardar(abb, clave, NULL));
+            esta[i] = true;
+        }else{
+            abb_borrar(abb, clave);
+            esta[i] = false;
+        }
+        if (op % CADA == 0) verificar(abb, esta, &estado);
+    }
+
+    abb_destruir(abb);
+    free(esta);
+    return 0;
+}
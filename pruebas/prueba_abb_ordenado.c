@@ -0,0 +1,262 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "abb.h"
+#include "pruebas.h"
+
+#define UNIVERSO 20000
+#define LARGO_MAX 16
+
+// Prueba abb_crear_desde_ordenado y abb_unir mezclando nodos del bloque de la
+// carga inicial con nodos pedidos de a uno al guardar: se borran nodos de los
+// dos tipos (también con dos hijos, que se reemplazan por su sucesor), se
+// reemplazan datos y se unen árboles con claves en común. Los datos se piden
+// con malloc y se cuentan las destrucciones; corriéndola con
+// -fsanitize=address se detecta además cualquier nodo o clave liberado de más
+// o de menos.
+
+static size_t destruidos = 0;
+
+static void destruir(void* dato){
+    destruidos ++;
+    free(dato);
+}
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void clave_de(char* clave, size_t i){
+    snprintf(clave, LARGO_MAX, "c%05zu", i);
+}
+
+// El dato de cada clave guarda su índice y de qué árbol viene.
+static size_t* dato_de(size_t i, size_t origen){
+    size_t* dato = malloc(2 * sizeof(size_t));
+    VERIFICAR(dato);
+    dato[0] = i;
+    dato[1] = origen;
+    return dato;
+}
+
+// Arma un abb con abb_crear_desde_ordenado con las claves i (en orden) tales
+// que incluir[i], con datos de 'origen'.
+static abb_t* cargar(const bool* incluir, size_t origen){
+    char (*copias)[LARGO_MAX] = malloc(UNIVERSO * sizeof(*copias));
+    const char** claves = malloc(UNIVERSO * sizeof(char*));
+    void** datos = malloc(UNIVERSO * sizeof(void*));
+    VERIFICAR(copias && claves && datos);
+    size_t n = 0;
+    for (size_t i = 0; i < UNIVERSO; i++){
+        if (!incluir[i]) continue;
+        clave_de(copias[n], i);
+        claves[n] = copias[n];
+        datos[n] = dato_de(i, origen);
+        n++;
+    }
+    abb_t* abb = abb_crear_desde_ordenado(strcmp, destruir, claves, datos, n);
+    VERIFICAR(abb && abb_cantidad(abb) == n);
+    // El abb copia las claves al bloque: las de la llamada ya no hacen falta.
+    free(datos);
+    free(claves);
+    free(copias);
+    return abb;
+}
+
+// Compara el abb con 'origen_de' (0 si la clave no está, o el árbol del que
+// viene su dato) recorriéndolo con el iterador y buscando cada clave.
+static void verificar(abb_t* abb, const size_t* origen_de){
+    char clave[LARGO_MAX];
+    abb_iter_t* iter = abb_iter_in_crear(abb);
+    VERIFICAR(iter);
+    size_t cant = 0;
+    for (size_t i = 0; i < UNIVERSO; i++){
+        clave_de(clave, i);
+        size_t* dato = abb_obtener(abb, clave);
+        if (!origen_de[i]){
+            VERIFICAR(!dato && !abb_pertenece(abb, clave));
+            continue;
+        }
+        VERIFICAR(dato && dato[0] == i && dato[1] == origen_de[i]);
+        VERIFICAR(strcmp(abb_iter_in_ver_actual(iter), clave) == 0);
+        VERIFICAR(strcmp(abb_seleccionar(abb, cant), clave) == 0);
+        abb_iter_in_avanzar(iter);
+        cant ++;
+    }
+    VERIFICAR(abb_iter_in_al_final(iter));
+    abb_iter_in_destruir(iter);
+    VERIFICAR(abb_cantidad(abb) == cant);
+}
+
+static void probar_claves_invalidas(void){
+    const char* desordenadas[] = {"a", "c", "b"};
+    const char* repetidas[] = {"a", "b", "b"};
+    VERIFICAR(abb_crear_desde_ordenado(strcmp, NULL, desordenadas, NULL, 3) == NULL);
+    VERIFICAR(abb_crear_desde_ordenado(strcmp, NULL, repetidas, NULL, 3) == NULL);
+    abb_t* vacio = abb_crear_desde_ordenado(strcmp, NULL, NULL, NULL, 0);
+    VERIFICAR(vacio && abb_cantidad(vacio) == 0);
+    VERIFICAR(abb_guardar(vacio, "a", NULL) && abb_pertenece(vacio, "a"));
+    abb_destruir(vacio);
+}
+
+// Carga las claves pares, guarda las impares y borra claves de los dos tipos al azar.
+static void probar_carga_y_borrados(uint64_t* estado){
+    bool* incluir = calloc(UNIVERSO, sizeof(bool));
+    size_t* origen_de = calloc(UNIVERSO, sizeof(size_t));
+    VERIFICAR(incluir && origen_de);
+    for (size_t i = 0; i < UNIVERSO; i += 2){
+        incluir[i] = true;
+        origen_de[i] = 1;
+    }
+    abb_t* abb = cargar(incluir, 1);
+    verificar(abb, origen_de);
+
+    char clave[LARGO_MAX];
+    for (size_t i = 1; i < UNIVERSO; i += 2){
+        clave_de(clave, i);
+        VERIFICAR(abb_guardar(abb, clave, dato_de(i, 2)));
+        origen_de[i] = 2;
+    }
+    verificar(abb, origen_de);
+
+    // Reemplazar el dato de nodos del bloque destruye el anterior.
+    size_t reemplazados = 0;
+    for (size_t i = 0; i < UNIVERSO; i += 10){
+        clave_de(clave, i);
+        VERIFICAR(abb_guardar(abb, clave, dato_de(i, 3)));
+        origen_de[i] = 3;
+        reemplazados ++;
+    }
+    VERIFICAR(destruidos == reemplazados);
+
+    // Se borran tres cuartos de las claves en orden aleatorio, y se vuelven a
+    // guardar algunas: sus nodos nuevos ya no son del bloque.
+    size_t quedan = UNIVERSO;
+    for (size_t c = 0; c < 3 * UNIVERSO; c++){
+        size_t i = aleatorio(estado) % UNIVERSO;
+        clave_de(clave, i);
+        if (origen_de[i] && quedan > UNIVERSO / 4){
+            size_t* dato = abb_borrar(abb, clave);
+            VERIFICAR(dato && dato[0] == i && dato[1] == origen_de[i]);
+            free(dato);
+            origen_de[i] = 0;
+            quedan --;
+        }else if (!origen_de[i] && c % 7 == 0){
+            VERIFICAR(abb_guardar(abb, clave, dato_de(i, 4)));
+            origen_de[i] = 4;
+            quedan ++;
+        }
+        if (c % 5000 == 0) verificar(abb, origen_de);
+    }
+    verificar(abb, origen_de);
+    VERIFICAR(destruidos == reemplazados);
+
+    // Vaciarlo del todo y volver a llenarlo.
+    for (size_t i = 0; i < UNIVERSO; i++){
+        if (!origen_de[i]) continue;
+        clave_de(clave, i);
+        free(abb_borrar(abb, clave));
+        origen_de[i] = 0;
+    }
+    verificar(abb, origen_de);
+    for (size_t i = 0; i < UNIVERSO; i += 3){
+        clave_de(clave, i);
+        VERIFICAR(abb_guardar(abb, clave, dato_de(i, 5)));
+        origen_de[i] = 5;
+    }
+    verificar(abb, origen_de);
+    destruidos = 0;
+    abb_destruir(abb);
+    VERIFICAR(destruidos == (UNIVERSO + 2) / 3);
+    free(origen_de);
+    free(incluir);
+}
+
+// Une dos árboles cargados en bloque, con nodos agregados y borrados, y con
+// claves en común: quedan los datos de origen y se destruyen los de destino.
+static void probar_unir(uint64_t* estado){
+    bool* en_a = calloc(UNIVERSO, sizeof(bool));
+    bool* en_b = calloc(UNIVERSO, sizeof(bool));
+    size_t* origen_de = calloc(UNIVERSO, sizeof(size_t));
+    VERIFICAR(en_a && en_b && origen_de);
+    for (size_t i = 0; i < UNIVERSO; i++){
+        en_a[i] = i % 2 == 0;
+        en_b[i] = i % 3 == 0;
+    }
+    abb_t* a = cargar(en_a, 1);
+    abb_t* b = cargar(en_b, 2);
+    char clave[LARGO_MAX];
+    // Nodos sueltos en los dos, también en común, y algunos borrados.
+    for (size_t i = 1; i < UNIVERSO; i += 10){
+        clave_de(clave, i);
+        if (!en_a[i]){
+            VERIFICAR(abb_guardar(a, clave, dato_de(i, 1)));
+            en_a[i] = true;
+        }
+        if (!en_b[i]){
+            VERIFICAR(abb_guardar(b, clave, dato_de(i, 2)));
+            en_b[i] = true;
+        }
+    }
+    for (size_t c = 0; c < UNIVERSO / 4; c++){
+        size_t i = aleatorio(estado) % UNIVERSO;
+        clave_de(clave, i);
+        abb_t* abb = c % 2 ? a : b;
+        bool* esta = c % 2 ? en_a : en_b;
+        if (esta[i]) free(abb_borrar(abb, clave));
+        esta[i] = false;
+    }
+    size_t comunes = 0;
+    for (size_t i = 0; i < UNIVERSO; i++){
+        origen_de[i] = en_b[i] ? 2 : en_a[i] ? 1 : 0;
+        if (en_a[i] && en_b[i]) comunes ++;
+    }
+
+    destruidos = 0;
+    VERIFICAR(abb_unir(a, b));
+    VERIFICAR(destruidos == comunes);
+    verificar(a, origen_de);
+
+    // El árbol unido tiene nodos de los dos bloques y sueltos: se borran y
+    // agregan claves, y se une con árboles vacíos.
+    for (size_t c = 0; c < UNIVERSO; c++){
+        size_t i = aleatorio(estado) % UNIVERSO;
+        clave_de(clave, i);
+        if (origen_de[i]){
+            free(abb_borrar(a, clave));
+            origen_de[i] = 0;
+        }else{
+            VERIFICAR(abb_guardar(a, clave, dato_de(i, 3)));
+            origen_de[i] = 3;
+        }
+    }
+    verificar(a, origen_de);
+    abb_t* vacio = abb_crear(strcmp, destruir);
+    VERIFICAR(vacio && abb_unir(a, vacio));
+    verificar(a, origen_de);
+    vacio = abb_crear(strcmp, destruir);
+    VERIFICAR(vacio && abb_unir(vacio, a));
+    verificar(vacio, origen_de);
+
+    size_t cant = abb_cantidad(vacio);
+    destruidos = 0;
+    abb_destruir(vacio);
+    VERIFICAR(destruidos == cant);
+    free(origen_de);
+    free(en_b);
+    free(en_a);
+}
+
+int main(void){
+    uint64_t estado = 88172645463325252ULL;
+    probar_claves_invalidas();
+    probar_carga_y_borrados(&estado);
+    probar_unir(&estado);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "abb.h"
+#include "pruebas.h"
+
+#define UNIVERSO 2000 // Claves posibles; el abb tiene a lo sumo las de índice par.
+#define CONSULTAS 2000
+#define LARGO_MAX 16
+#define ABIERTO SIZE_MAX // Índice de un extremo NULL.
+
+static bool esta[UNIVERSO]; // Claves que tiene el abb.
+
+// Verifica abb_iter_rango_crear y abb_iter_rango_crear_inverso con extremos
+// abiertos (NULL), en claves que están y que no están, iguales, invertidos y
+// fuera de las claves del abb. La clave i es "c" seguida de i con ceros a la
+// izquierda, así que el orden de los índices es el de las claves.
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void clave_de(char* clave, size_t i){
+    snprintf(clave, LARGO_MAX, "c%05zu", i);
+}
+
+// Recorre el rango [desde, hasta] (índices, o ABIERTO) con el iterador en el
+// sentido pedido y lo compara con las claves del rango que están en el abb.
+static void verificar_rango(const abb_t* abb, size_t desde, size_t hasta, bool inverso){
+    char clave_desde[LARGO_MAX], clave_hasta[LARGO_MAX], esperada[LARGO_MAX];
+    if (desde != ABIERTO) clave_de(clave_desde, desde);
+    if (hasta != ABIERTO) clave_de(clave_hasta, hasta);
+    const char* inicio = desde != ABIERTO ? clave_desde : NULL;
+    const char* fin = hasta != ABIERTO ? clave_hasta : NULL;
+    abb_iter_t* iter = inverso ? abb_iter_rango_crear_inverso(abb, inicio, fin) : abb_iter_rango_crear(abb, inicio, fin);
+    VERIFICAR(iter);
+
+    size_t primera = desde == ABIERTO ? 0 : desde;
+    size_t ultima = hasta == ABIERTO ? UNIVERSO - 1 : hasta;
+    size_t vistas = 0;
+    for (size_t j = 0; j < UNIVERSO; j++){
+        size_t i = inverso ? UNIVERSO - 1 - j : j;
+        if (!esta[i] || i < primera || i > ultima) continue;
+        clave_de(esperada, i);
+        VERIFICAR(!abb_iter_in_al_final(iter));
+        VERIFICAR(strcmp(abb_iter_in_ver_actual(iter), esperada) == 0);
+        abb_iter_in_avanzar(iter);
+        vistas ++;
+    }
+    VERIFICAR(abb_iter_in_al_final(iter));
+    VERIFICAR(abb_iter_in_ver_actual(iter) == NULL);
+    VERIFICAR(!abb_iter_in_avanzar(iter));
+    abb_iter_in_destruir(iter);
+    VERIFICAR(vistas == abb_contar_entre(abb, inicio, fin));
+}
+
+static void verificar_ambos(const abb_t* abb, size_t desde, size_t hasta){
+    verificar_rango(abb, desde, hasta, false);
+    verificar_rango(abb, desde, hasta, true);
+}
+
+int main(void){
+    abb_t* abb = abb_crear(strcmp, NULL);
+    VERIFICAR(abb);
+
+    // Abb vacío: todos los rangos son vacíos.
+    verificar_ambos(abb, ABIERTO, ABIERTO);
+    verificar_ambos(abb, 10, 20);
+
+    char clave[LARGO_MAX];
+    for (size_t i = 0; i < UNIVERSO; i += 2){
+        clave_de(clave, i);
+        VERIFICAR(abb_guardar(abb, clave, NULL));
+        esta[i] = true;
+    }
+
+    // Abiertos, cerrados y mixtos.
+    verificar_ambos(abb, ABIERTO, ABIERTO);
+    verificar_ambos(abb, 100, ABIERTO);
+    verificar_ambos(abb, ABIERTO, 100);
+    verificar_ambos(abb, 100, 200);
+    // Extremos en claves que no están (índices impares).
+    verificar_ambos(abb, 101, 199);
+    verificar_ambos(abb, 101, ABIERTO);
+    verificar_ambos(abb, ABIERTO, 199);
+    // Una sola clave, o ninguna entre dos claves consecutivas.
+    verificar_ambos(abb, 100, 100);
+    verificar_ambos(abb, 101, 101);
+    // Invertidos: vacíos.
+    verificar_ambos(abb, 200, 100);
+    verificar_ambos(abb, 102, 101);
+    // Primera y última clave, y fuera de las claves del abb.
+    verificar_ambos(abb, 0, 0);
+    verificar_ambos(abb, UNIVERSO - 2, UNIVERSO - 2);
+    verificar_ambos(abb, UNIVERSO - 1, ABIERTO);
+    verificar_ambos(abb, ABIERTO, 0);
+
+    // Extremos al azar, con claves borradas en el medio.
+    uint64_t estado = 88172645463325252ULL;
+    for (size_t i = 0; i < UNIVERSO; i += 6){
+        clave_de(clave, i);
+        VERIFICAR(abb_borrar(abb, clave) == NULL && !abb_pertenece(abb, clave));
+        esta[i] = false;
+    }
+    for (size_t c = 0; c < CONSULTAS; c++){
+        size_t desde = aleatorio(&estado) % (UNIVERSO + 1);
+        size_t hasta = aleatorio(&estado) % (UNIVERSO + 1);
+        verificar_ambos(abb, desde == UNIVERSO ? ABIERTO : desde, hasta == UNIVERSO ? ABIERTO : hasta);
+    }
+
+    abb_destruir(abb);
+    return 0;
+}
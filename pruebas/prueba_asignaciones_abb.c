@@ -0,0 +1,221 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "abb.h"
+#include "asignaciones.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 100000
+#define LARGO_MAX 24
+#define ALTURA_FIBONACCI 26 // Altura del AVL más alto que se arma, con fib(28) - 1 = 317810 nodos.
+
+// Cuenta los pedidos de memoria y las comparaciones de abb_guardar y abb_borrar:
+// actualizar no pide memoria, agregar pide sólo el nodo y la copia de la clave,
+// borrar no pide memoria, y cada operación baja una sola vez desde la raíz, así
+// que no hace más comparaciones que la altura del AVL. Verifica además que el
+// iterador sólo pide memoria al crearse, también en el AVL más alto posible
+// para su cantidad de nodos.
+
+static size_t comparaciones = 0;
+
+static int comparar(const char* a, const char* b){
+    comparaciones ++;
+    return strcmp(a, b);
+}
+
+// Resultados de una tanda de operaciones.
+typedef struct medicion{
+    size_t pedidos;
+    size_t liberaciones;
+    size_t comparaciones_max;
+    double comparaciones_medias;
+}medicion_t;
+
+typedef bool (*operacion_t)(abb_t* abb, const char* clave, size_t i);
+
+static bool guardar(abb_t* abb, const char* clave, size_t i){
+    return abb_guardar(abb, clave, (void*) (uintptr_t) (i + 1));
+}
+
+static bool borrar(abb_t* abb, const char* clave, size_t i){
+    return abb_borrar(abb, clave) == (void*) (uintptr_t) (i + 1);
+}
+
+static bool borrar_ausente(abb_t* abb, const char* clave, size_t i){
+    (void) i;
+    return abb_borrar(abb, clave) == NULL;
+}
+
+// Aplica la operación a las claves desde..hasta-1 (con el prefijo recibido).
+static medicion_t medir(abb_t* abb, operacion_t operacion, const char* prefijo, size_t desde, size_t hasta){
+    char clave[LARGO_MAX];
+    medicion_t medicion = {0, 0, 0, 0};
+    size_t total = 0;
+    reiniciar_asignaciones();
+    for (size_t i = desde; i < hasta; i++){
+        snprintf(clave, LARGO_MAX, "%s%zu", prefijo, (i * 7919) % (2 * CANT_CLAVES));
+        comparaciones = 0;
+        VERIFICAR(operacion(abb, clave, i));
+        total += comparaciones;
+        if (comparaciones > medicion.comparaciones_max) medicion.comparaciones_max = comparaciones;
+    }
+    medicion.pedidos = pedidos;
+    medicion.liberaciones = liberaciones;
+    medicion.comparaciones_medias = (double) total / (double) (hasta - desde);
+    return medicion;
+}
+
+static void informar(const char* nombre, medicion_t m, size_t operaciones){
+    printf("%-16s %10.2f %14.2f %14.2f %10zu\n", nombre, (double) m.pedidos / (double) operaciones,
+           (double) m.liberaciones / (double) operaciones, m.comparaciones_medias, m.comparaciones_max);
+}
+
+// Recorre el abb con el iterador y verifica que sólo crearlo y destruirlo piden
+// y liberan memoria (el iterador mismo): avanzar y reiniciar no piden nada.
+static void verificar_iterador(abb_t* abb, abb_t* otro){
+    reiniciar_asignaciones();
+    abb_iter_t* iter = abb_iter_in_crear(abb);
+    VERIFICAR(iter);
+    VERIFICAR(pedidos == 1);
+    for (size_t vuelta = 0; vuelta < 2; vuelta++){
+        size_t vistas = 0;
+        const char* anterior = NULL;
+        for (; !abb_iter_in_al_final(iter); abb_iter_in_avanzar(iter)){
+            const char* actual = abb_iter_in_ver_actual(iter);
+            VERIFICAR(!anterior || strcmp(anterior, actual) < 0);
+            anterior = actual;
+            vistas ++;
+        }
+        VERIFICAR(vistas == abb_cantidad(abb));
+        abb_iter_in_reiniciar(iter, abb);
+    }
+    // Reiniciado sobre otro abb, lo recorre desde su primera clave.
+    abb_iter_in_reiniciar(iter, otro);
+    size_t vistas = 0;
+    for (; !abb_iter_in_al_final(iter); abb_iter_in_avanzar(iter)) vistas ++;
+    VERIFICAR(vistas == abb_cantidad(otro));
+    VERIFICAR(pedidos == 1 && liberaciones == 0);
+    abb_iter_in_destruir(iter);
+    VERIFICAR(pedidos == 1 && liberaciones == 1);
+}
+
+// Cantidad mínima de nodos de un AVL de altura h: fib(h + 2) - 1.
+static double nodos_minimos(size_t h){
+    double anterior = 0, actual = 1; // Para alturas 0 y 1.
+    if (h == 0) return 0;
+    for (size_t i = 1; i < h; i++){
+        double siguiente = actual + anterior + 1;
+        anterior = actual;
+        actual = siguiente;
+    }
+    return actual;
+}
+
+// Guarda en 'orden', recorriendo por niveles, las claves del árbol de
+// Fibonacci de altura h sobre las posiciones in order [0, nodos_minimos(h)):
+// la raíz tiene un subárbol izquierdo de altura h - 1 y uno derecho de altura
+// h - 2. Guardar las claves en ese orden arma ese mismo árbol, que es un AVL
+// válido en cada paso, sin rotaciones: el AVL más alto para su cantidad de nodos.
+static size_t ordenar_por_niveles(size_t h, size_t* orden){
+    typedef struct subarbol{ size_t inicio, altura; }subarbol_t;
+    size_t n = (size_t) nodos_minimos(h);
+    subarbol_t* cola = malloc(n * sizeof(subarbol_t));
+    VERIFICAR(cola);
+    size_t primero = 0, ultimo = 0, cant = 0;
+    cola[ultimo++] = (subarbol_t) {0, h};
+    while (primero < ultimo){
+        subarbol_t sub = cola[primero++];
+        size_t raiz = sub.inicio + (size_t) nodos_minimos(sub.altura - 1);
+        orden[cant++] = raiz;
+        if (sub.altura >= 2) cola[ultimo++] = (subarbol_t) {sub.inicio, sub.altura - 1};
+        if (sub.altura >= 3) cola[ultimo++] = (subarbol_t) {raiz + 1, sub.altura - 2};
+    }
+    free(cola);
+    return cant;
+}
+
+// Con el AVL más alto que se puede armar en memoria razonable, las búsquedas
+// bajan exactamente ALTURA_FIBONACCI niveles y el iterador, cuya pila tiene
+// lugar para ALTURA_MAX (96, en abb.c) nodos, lo recorre sin pedir memoria.
+// Un AVL de altura ALTURA_MAX no cabe en memoria: necesitaría fib(98) - 1
+// nodos, más que 2^64 bytes.
+static void probar_altura_maxima(abb_t* otro){
+    VERIFICAR(nodos_minimos(96) > 18446744073709551616.0);
+    size_t n = (size_t) nodos_minimos(ALTURA_FIBONACCI);
+    size_t* orden = malloc(n * sizeof(size_t));
+    VERIFICAR(orden);
+    VERIFICAR(ordenar_por_niveles(ALTURA_FIBONACCI, orden) == n);
+    abb_t* abb = abb_crear(comparar, NULL);
+    VERIFICAR(abb);
+    char clave[LARGO_MAX];
+    for (size_t i = 0; i < n; i++){
+        snprintf(clave, LARGO_MAX, "%07zu", orden[i]);
+        VERIFICAR(abb_guardar(abb, clave, NULL));
+    }
+    VERIFICAR(abb_cantidad(abb) == n);
+    size_t comparaciones_max = 0;
+    for (size_t i = 0; i < n; i++){
+        snprintf(clave, LARGO_MAX, "%07zu", i);
+        comparaciones = 0;
+        VERIFICAR(abb_pertenece(abb, clave));
+        if (comparaciones > comparaciones_max) comparaciones_max = comparaciones;
+    }
+    VERIFICAR(comparaciones_max == ALTURA_FIBONACCI);
+    printf("AVL de Fibonacci: %zu nodos, altura %zu\n", n, comparaciones_max);
+    verificar_iterador(abb, otro);
+
+    // Los iteradores de rango y los inversos arrancan desde la clave más profunda.
+    snprintf(clave, LARGO_MAX, "%07zu", orden[n - 1]);
+    abb_iter_t* iter = abb_iter_rango_crear_inverso(abb, NULL, clave);
+    VERIFICAR(iter);
+    size_t vistas = 0;
+    for (; !abb_iter_in_al_final(iter); abb_iter_in_avanzar(iter)) vistas ++;
+    VERIFICAR(vistas == orden[n - 1] + 1);
+    abb_iter_in_destruir(iter);
+    free(orden);
+    abb_destruir(abb);
+}
+
+int main(void){
+    abb_t* abb = abb_crear(comparar, NULL);
+    VERIFICAR(abb);
+    // Con a lo sumo 2 * CANT_CLAVES nodos, la altura del AVL no pasa de 1.44 log2(n + 2).
+    size_t altura_max = (size_t) (1.45 * log2(2 * CANT_CLAVES + 2));
+
+    printf("%-16s %10s %14s %14s %10s\n", "operación", "pedidos", "liberaciones", "comparaciones", "máximo");
+    medicion_t agregar = medir(abb, guardar, "clave:", 0, CANT_CLAVES);
+    informar("agregar", agregar, CANT_CLAVES);
+    VERIFICAR(agregar.pedidos == 2 * CANT_CLAVES); // El nodo y la copia de la clave.
+    VERIFICAR(agregar.liberaciones == 0);
+    VERIFICAR(agregar.comparaciones_max <= altura_max);
+
+    medicion_t actualizar = medir(abb, guardar, "clave:", 0, CANT_CLAVES);
+    informar("actualizar", actualizar, CANT_CLAVES);
+    VERIFICAR(actualizar.pedidos == 0 && actualizar.liberaciones == 0);
+    VERIFICAR(actualizar.comparaciones_max <= altura_max);
+
+    medicion_t ausentes = medir(abb, borrar_ausente, "ausente:", 0, CANT_CLAVES);
+    informar("borrar ausente", ausentes, CANT_CLAVES);
+    VERIFICAR(ausentes.pedidos == 0 && ausentes.liberaciones == 0);
+    VERIFICAR(ausentes.comparaciones_max <= altura_max);
+
+    // Borrar la mitad de las claves, muchas de ellas con dos hijos.
+    medicion_t borrados = medir(abb, borrar, "clave:", 0, CANT_CLAVES / 2);
+    informar("borrar", borrados, CANT_CLAVES / 2);
+    VERIFICAR(borrados.pedidos == 0);
+    VERIFICAR(borrados.liberaciones == 2 * (CANT_CLAVES / 2)); // El nodo y su clave.
+    VERIFICAR(borrados.comparaciones_max <= altura_max);
+    VERIFICAR(abb_cantidad(abb) == CANT_CLAVES - CANT_CLAVES / 2);
+
+    abb_t* vacio = abb_crear(comparar, NULL);
+    VERIFICAR(vacio);
+    verificar_iterador(abb, vacio);
+    probar_altura_maxima(abb);
+    abb_destruir(vacio);
+
+    abb_destruir(abb);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "asignaciones.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 5000
+#define LARGO_MAX 40
+
+// Arma la clave número i: las pares son cortas (se guardan dentro de la tabla)
+// y las impares largas (se copian a memoria dinámica).
+static void armar_clave(char* clave, size_t i, const char* prefijo){
+    if (i % 2 == 0) snprintf(clave, LARGO_MAX, "%s%zu", prefijo, i);
+    else snprintf(clave, LARGO_MAX, "%s-clave-larga-numero-%zu", prefijo, i);
+}
+
+// Verifica que consultar, actualizar y borrar claves ausentes no pida memoria.
+static void verificar_sin_asignaciones(hash_t* hash, const char* descripcion){
+    char clave[LARGO_MAX];
+    reiniciar_asignaciones();
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        armar_clave(clave, i, "k");
+        VERIFICAR(hash_obtener(hash, clave) == (void*) (i + 1));
+        VERIFICAR(hash_pertenece(hash, clave));
+        armar_clave(clave, i, "ausente");
+        VERIFICAR(hash_obtener(hash, clave) == NULL);
+        VERIFICAR(!hash_pertenece(hash, clave));
+    }
+    size_t pedidos_lectura = pedidos;
+
+    reiniciar_asignaciones();
+    const char* claves[CANT_CLAVES];
+    void* datos[CANT_CLAVES];
+    char copias[CANT_CLAVES][LARGO_MAX];
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        armar_clave(copias[i], i, "k");
+        claves[i] = copias[i];
+    }
+    hash_obtener_lote(hash, claves, CANT_CLAVES, datos);
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(datos[i] == (void*) (i + 1));
+    size_t pedidos_lote = pedidos;
+
+    // Actualizar claves existentes no pide memoria. Sólo puede liberar la tabla
+    // anterior, si termina de migrarla.
+    reiniciar_asignaciones();
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        armar_clave(clave, i, "k");
+        VERIFICAR(hash_guardar(hash, clave, (void*) (i + 1)));
+    }
+    size_t pedidos_actualizacion = pedidos, liberaciones_actualizacion = liberaciones;
+
+    reiniciar_asignaciones();
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        armar_clave(clave, i, "ausente");
+        VERIFICAR(hash_borrar(hash, clave) == NULL);
+    }
+    size_t pedidos_borrado = pedidos;
+
+    printf("%s: pedidos al leer %zu, en lote %zu, al actualizar %zu (liberaciones %zu), al borrar ausentes %zu\n",
+           descripcion, pedidos_lectura, pedidos_lote, pedidos_actualizacion, liberaciones_actualizacion, pedidos_borrado);
+    VERIFICAR(pedidos_lectura == 0);
+    VERIFICAR(pedidos_lote == 0);
+    VERIFICAR(pedidos_actualizacion == 0);
+    VERIFICAR(pedidos_borrado == 0);
+}
+
+static hash_t* crear_lleno(const hash_opciones_t* opciones, size_t cantidad){
+    hash_t* hash = hash_crear_con_opciones(NULL, opciones);
+    VERIFICAR(hash);
+    char clave[LARGO_MAX];
+    for (size_t i = 0; i < cantidad; i++){
+        armar_clave(clave, i, "k");
+        VERIFICAR(hash_guardar(hash, clave, (void*) (i + 1)));
+    }
+    return hash;
+}
+
+int main(void){
+    hash_t* hash = crear_lleno(NULL, CANT_CLAVES);
+    verificar_sin_asignaciones(hash, "hash");
+    hash_destruir(hash);
+
+    // Con una migración en curso las búsquedas recorren las dos tablas. Con
+    // 6964 claves una tabla de 8192 posiciones llega al factor de carga máximo,
+    // así que la clave siguiente la agranda.
+    hash = crear_lleno(NULL, 6965);
+    VERIFICAR(hash_estadisticas(hash).pendientes > 0);
+    verificar_sin_asignaciones(hash, "hash migrando");
+    hash_destruir(hash);
+
+    hash_opciones_t con_filtro = {.tasa_falsos_positivos = 0.01};
+    hash = crear_lleno(&con_filtro, CANT_CLAVES);
+    verificar_sin_asignaciones(hash, "hash con filtro");
+    hash_destruir(hash);
+
+    intern_t* intern = intern_crear();
+    VERIFICAR(intern);
+    hash_opciones_t con_intern = {.intern = intern};
+    hash = crear_lleno(&con_intern, CANT_CLAVES);
+    verificar_sin_asignaciones(hash, "hash con intern");
+    hash_destruir(hash);
+    intern_destruir(intern);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "btree.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 20000
+#define LARGO_MAX 32
+
+// Con strcmp el árbol compara prefijos; con otra función, sólo claves.
+static int comparar(const char* a, const char* b){
+    return strcmp(a, b);
+}
+
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void probar(btree_comparar_clave_t cmp){
+    char (*claves)[LARGO_MAX] = malloc(CANT_CLAVES * sizeof(*claves));
+    size_t* orden = malloc(CANT_CLAVES * sizeof(size_t));
+    VERIFICAR(claves && orden);
+    // Claves con el mismo prefijo de 8 bytes, para que haya que leerlas.
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        snprintf(claves[i], LARGO_MAX, "registro/%06zu", i);
+        orden[i] = i;
+    }
+    uint64_t estado = 88172645463325252ULL;
+    for (size_t i = CANT_CLAVES - 1; i > 0; i--){
+        size_t j = aleatorio(&estado) % (i + 1);
+        size_t aux = orden[i];
+        orden[i] = orden[j];
+        orden[j] = aux;
+    }
+
+    btree_t* arbol = btree_crear(cmp, NULL);
+    VERIFICAR(arbol);
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(btree_guardar(arbol, claves[orden[i]], claves[orden[i]]));
+    VERIFICAR(btree_cantidad(arbol) == CANT_CLAVES);
+    // Se borran las claves impares, en orden aleatorio.
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        if (orden[i] % 2 == 1) VERIFICAR(btree_borrar(arbol, claves[orden[i]]) == claves[orden[i]]);
+    }
+    VERIFICAR(btree_cantidad(arbol) == CANT_CLAVES / 2);
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(btree_pertenece(arbol, claves[i]) == (i % 2 == 0));
+
+    // El iterador recorre las claves en orden y avanzar devuelve true cada vez que
+    // avanza, incluso desde la última clave.
+    btree_iter_t* iter = btree_iter_in_crear(arbol);
+    VERIFICAR(iter);
+    size_t vistas = 0;
+    while (!btree_iter_in_al_final(iter)){
+        VERIFICAR(strcmp(btree_iter_in_ver_actual(iter), claves[2 * vistas]) == 0);
+        VERIFICAR(btree_iter_in_avanzar(iter));
+        vistas ++;
+    }
+    VERIFICAR(vistas == CANT_CLAVES / 2);
+    VERIFICAR(!btree_iter_in_avanzar(iter));
+    VERIFICAR(btree_iter_in_ver_actual(iter) == NULL);
+    btree_iter_in_destruir(iter);
+
+    btree_destruir(arbol);
+    free(orden);
+    free(claves);
+}
+
+int main(void){
+    probar(strcmp);
+    probar(comparar);
+    return 0;
+}
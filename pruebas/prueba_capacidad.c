@@ -0,0 +1,140 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "asignaciones.h"
+#include "pruebas.h"
+
+#define CAPACIDAD 10000
+#define REPETICIONES 1000
+#define LARGO_MAX 24
+
+// Verifica que con la capacidad pedida de antemano (al crear el hash o con
+// hash_reservar) guardar esa cantidad de claves no redimensiona ni pide memoria,
+// que hash_compactar achica la tabla, y que guardar y borrar alrededor de un
+// umbral no agranda y achica la tabla una y otra vez.
+// Las claves son cortas, así que se guardan dentro de la tabla y no piden memoria.
+
+static void clave_de(char* clave, size_t i){
+    snprintf(clave, LARGO_MAX, "%zu", i);
+}
+
+static void guardar_claves(hash_t* hash, size_t desde, size_t hasta){
+    char clave[LARGO_MAX];
+    for (size_t i = desde; i < hasta; i++){
+        clave_de(clave, i);
+        VERIFICAR(hash_guardar(hash, clave, (void*) (uintptr_t) (i + 1)));
+    }
+}
+
+static void verificar_claves(const hash_t* hash, size_t desde, size_t hasta){
+    char clave[LARGO_MAX];
+    for (size_t i = desde; i < hasta; i++){
+        clave_de(clave, i);
+        VERIFICAR(hash_obtener(hash, clave) == (void*) (uintptr_t) (i + 1));
+    }
+}
+
+// Crear el hash pide el struct y la tabla; guardar las claves no pide nada más.
+static void probar_crear_con_capacidad(void){
+    reiniciar_asignaciones();
+    hash_t* hash = hash_crear_con_capacidad(NULL, CAPACIDAD);
+    VERIFICAR(hash);
+    VERIFICAR(pedidos == 2);
+    reiniciar_asignaciones();
+    guardar_claves(hash, 0, CAPACIDAD);
+    VERIFICAR(pedidos == 0);
+    hash_estadisticas_t estadisticas = hash_estadisticas(hash);
+    VERIFICAR(estadisticas.redimensiones == 0);
+    VERIFICAR(estadisticas.cantidad == CAPACIDAD);
+    verificar_claves(hash, 0, CAPACIDAD);
+    hash_destruir(hash);
+}
+
+// Reservar pide sólo la tabla nueva, de una sola vez.
+static void probar_reservar(void){
+    hash_t* hash = hash_crear(NULL);
+    VERIFICAR(hash);
+    guardar_claves(hash, 0, 10);
+    reiniciar_asignaciones();
+    VERIFICAR(hash_reservar(hash, CAPACIDAD));
+    VERIFICAR(pedidos == 1);
+    VERIFICAR(hash_estadisticas(hash).redimensiones == 1);
+    reiniciar_asignaciones();
+    guardar_claves(hash, 10, CAPACIDAD);
+    VERIFICAR(pedidos == 0);
+    VERIFICAR(hash_estadisticas(hash).redimensiones == 1);
+
+    // Lo reservado no se achica al borrar, hasta compactar.
+    char clave[LARGO_MAX];
+    for (size_t i = 100; i < CAPACIDAD; i++){
+        clave_de(clave, i);
+        VERIFICAR(hash_borrar(hash, clave) == (void*) (uintptr_t) (i + 1));
+    }
+    hash_estadisticas_t antes = hash_estadisticas(hash);
+    VERIFICAR(antes.redimensiones == 1);
+    VERIFICAR(hash_compactar(hash));
+    hash_estadisticas_t despues = hash_estadisticas(hash);
+    VERIFICAR(despues.tam < antes.tam);
+    VERIFICAR(despues.redimensiones == 2);
+    VERIFICAR(despues.cantidad == 100);
+    VERIFICAR(despues.factor_carga <= 0.85);
+    verificar_claves(hash, 0, 100);
+    hash_destruir(hash);
+}
+
+// Agrega una clave y la borra REPETICIONES veces con la carga en el umbral.
+static void alternar(hash_t* hash, size_t clave_nueva){
+    char clave[LARGO_MAX];
+    clave_de(clave, clave_nueva);
+    for (size_t i = 0; i < REPETICIONES; i++){
+        VERIFICAR(hash_guardar(hash, clave, (void*) (uintptr_t) (clave_nueva + 1)));
+        VERIFICAR(hash_borrar(hash, clave) == (void*) (uintptr_t) (clave_nueva + 1));
+    }
+}
+
+static void probar_histeresis(void){
+    hash_t* hash = hash_crear(NULL);
+    VERIFICAR(hash);
+    // Se guardan claves hasta que la tabla crece.
+    size_t cant = 0;
+    while (hash_estadisticas(hash).redimensiones == 0){
+        guardar_claves(hash, cant, cant + 1);
+        cant ++;
+    }
+    size_t redimensiones = hash_estadisticas(hash).redimensiones;
+    alternar(hash, CAPACIDAD);
+    VERIFICAR(hash_estadisticas(hash).redimensiones == redimensiones);
+    hash_borrar(hash, "0");
+    alternar(hash, CAPACIDAD);
+    VERIFICAR(hash_estadisticas(hash).redimensiones == redimensiones);
+
+    // Se guardan más claves y se borran hasta que la tabla se achica.
+    guardar_claves(hash, cant, CAPACIDAD);
+    size_t tam = hash_estadisticas(hash).tam;
+    char clave[LARGO_MAX];
+    size_t borradas = 1;
+    while (hash_estadisticas(hash).tam == tam){
+        clave_de(clave, borradas);
+        VERIFICAR(hash_borrar(hash, clave));
+        borradas ++;
+    }
+    redimensiones = hash_estadisticas(hash).redimensiones;
+    alternar(hash, CAPACIDAD);
+    VERIFICAR(hash_estadisticas(hash).redimensiones == redimensiones);
+    guardar_claves(hash, 1, 2);
+    alternar(hash, CAPACIDAD);
+    VERIFICAR(hash_estadisticas(hash).redimensiones == redimensiones);
+    hash_destruir(hash);
+}
+
+int main(void){
+    // La primera semilla aleatoria abre /dev/urandom, lo que pide memoria.
+    hash_semilla_aleatoria();
+    probar_crear_con_capacidad();
+    probar_reservar();
+    probar_histeresis();
+    return 0;
+}
@@ -0,0 +1,118 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash.h"
+#include "pruebas.h"
+
+#define BLOQUES 12 // Claves de BLOQUES bloques: 2^BLOQUES claves.
+#define CANT_CLAVES (1 << BLOQUES)
+#define LARGO_CLAVE (2 * BLOQUES)
+#define SONDEO_MAX_ADMITIDO 32
+#define HILOS_SEMILLAS 4
+#define SEMILLAS_POR_HILO 20000
+
+// Las claves son concatenaciones de los bloques "Ab" y "BA", que tienen el mismo
+// valor en djb2 ('A' * 33 + 'b' == 'B' * 33 + 'A'): todas las claves colisionan
+// entre sí con djb2 para cualquier semilla, como las que armaría un atacante.
+static char* crear_claves(void){
+    char* claves = malloc(CANT_CLAVES * (LARGO_CLAVE + 1));
+    VERIFICAR(claves);
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        char* clave = claves + i * (LARGO_CLAVE + 1);
+        for (size_t b = 0; b < BLOQUES; b++){
+            memcpy(clave + 2 * b, (i >> b) & 1 ? "BA" : "Ab", 2);
+        }
+        clave[LARGO_CLAVE] = '\0';
+    }
+    return claves;
+}
+
+// Guarda todas las claves en un hash creado con las opciones dadas, verifica que
+// se encuentren y devuelve el mayor largo de búsqueda.
+static size_t sondeo_max(const char* claves, const hash_opciones_t* opciones){
+    hash_t* hash = hash_crear_con_opciones(NULL, opciones);
+    VERIFICAR(hash);
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        VERIFICAR(hash_guardar(hash, claves + i * (LARGO_CLAVE + 1), (void*) (claves + i)));
+    }
+    VERIFICAR(hash_cantidad(hash) == CANT_CLAVES);
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        VERIFICAR(hash_obtener(hash, claves + i * (LARGO_CLAVE + 1)) == claves + i);
+    }
+    size_t resultado = hash_estadisticas(hash).sondeo_max;
+    hash_destruir(hash);
+    return resultado;
+}
+
+// Pide semillas desde un hilo, como al crear tablas desde varios hilos a la vez.
+static void* pedir_semillas(void* extra){
+    uint64_t* semillas = extra;
+    for (size_t i = 0; i < SEMILLAS_POR_HILO; i++) semillas[i] = hash_semilla_aleatoria();
+    return NULL;
+}
+
+static int comparar_semillas(const void* a, const void* b){
+    uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+// Las semillas pedidas desde varios hilos a la vez nunca se repiten.
+static void verificar_semillas_concurrentes(void){
+    uint64_t* semillas = malloc(HILOS_SEMILLAS * SEMILLAS_POR_HILO * sizeof(uint64_t));
+    VERIFICAR(semillas);
+    pthread_t hilos[HILOS_SEMILLAS];
+    for (size_t i = 0; i < HILOS_SEMILLAS; i++){
+        VERIFICAR(pthread_create(&hilos[i], NULL, pedir_semillas, semillas + i * SEMILLAS_POR_HILO) == 0);
+    }
+    for (size_t i = 0; i < HILOS_SEMILLAS; i++) pthread_join(hilos[i], NULL);
+    qsort(semillas, HILOS_SEMILLAS * SEMILLAS_POR_HILO, sizeof(uint64_t), comparar_semillas);
+    for (size_t i = 0; i < HILOS_SEMILLAS * SEMILLAS_POR_HILO; i++){
+        VERIFICAR(semillas[i] != 0);
+        if (i > 0) VERIFICAR(semillas[i] != semillas[i - 1]);
+    }
+    free(semillas);
+}
+
+int main(void){
+    char* claves = crear_claves();
+
+    // Las claves efectivamente colisionan con djb2, con o sin semilla.
+    hash_opciones_t djb2 = {.funcion = hash_funcion_djb2};
+    uint64_t primero = hash_funcion_djb2(claves, LARGO_CLAVE, 1);
+    for (size_t i = 1; i < CANT_CLAVES; i++){
+        VERIFICAR(hash_funcion_djb2(claves + i * (LARGO_CLAVE + 1), LARGO_CLAVE, 1) == primero);
+    }
+    size_t sondeo_djb2 = sondeo_max(claves, &djb2);
+    VERIFICAR(sondeo_djb2 == CANT_CLAVES);
+
+    // La función por omisión, con una semilla aleatoria por tabla, las reparte.
+    size_t sondeo_rapida = sondeo_max(claves, NULL);
+    VERIFICAR(sondeo_rapida <= SONDEO_MAX_ADMITIDO);
+
+    // Tablas distintas tienen semillas distintas: una colisión hallada contra una
+    // no sirve contra otra.
+    uint64_t semilla_a = hash_semilla_aleatoria(), semilla_b = hash_semilla_aleatoria();
+    VERIFICAR(semilla_a != 0 && semilla_b != 0 && semilla_a != semilla_b);
+    VERIFICAR(hash_funcion_rapida(claves, LARGO_CLAVE, semilla_a) != hash_funcion_rapida(claves, LARGO_CLAVE, semilla_b));
+
+    verificar_semillas_concurrentes();
+
+    // La función rápida depende de todos los bytes para cualquier largo de clave.
+    char clave[64];
+    memset(clave, 'x', sizeof(clave));
+    for (size_t largo = 1; largo <= sizeof(clave); largo++){
+        uint64_t original = hash_funcion_rapida(clave, largo, semilla_a);
+        for (size_t i = 0; i < largo; i++){
+            clave[i] = 'y';
+            VERIFICAR(hash_funcion_rapida(clave, largo, semilla_a) != original);
+            clave[i] = 'x';
+        }
+    }
+
+    printf("sondeo máximo con %d claves: djb2 %zu, rápida %zu\n", CANT_CLAVES, sondeo_djb2, sondeo_rapida);
+    free(claves);
+    return 0;
+}
@@ -0,0 +1,167 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_concurrente.h"
+#include "pruebas.h"
+
+#define ESCRITORES 4
+#define LECTORES 4
+#define LARGO_MAX 64
+#define SEGUNDOS_FASE 1.0
+
+// Claves y duración de cada fase. Con pocas claves los hilos compiten por las
+// mismas posiciones; con muchas, los segmentos crecen y se achican todo el tiempo.
+typedef struct fase{
+    const char* nombre;
+    size_t cant_claves;
+}fase_t;
+
+typedef struct compartido{
+    hash_concurrente_t* hash;
+    char (*claves)[LARGO_MAX];
+    size_t cant_claves;
+    double fin;
+    size_t errores;
+    pthread_mutex_t mutex_errores;
+}compartido_t;
+
+typedef struct hilo{
+    compartido_t* compartido;
+    size_t id;
+    size_t operaciones;
+    pthread_t hilo;
+}hilo_t;
+
+// El dato de una clave codifica su índice y el escritor que la guardó, para que
+// los lectores puedan verificar que el dato corresponde a la clave buscada.
+static void* dato_de(size_t indice, size_t escritor){
+    return (void*) (uintptr_t) ((indice << 8) | (escritor + 1));
+}
+
+static size_t indice_de(void* dato){
+    return (size_t) ((uintptr_t) dato >> 8);
+}
+
+// Generador xorshift, uno por hilo.
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static void informar_error(compartido_t* compartido){
+    pthread_mutex_lock(&compartido->mutex_errores);
+    compartido->errores ++;
+    pthread_mutex_unlock(&compartido->mutex_errores);
+}
+
+static void* escribir(void* extra){
+    hilo_t* hilo = extra;
+    compartido_t* c = hilo->compartido;
+    uint64_t estado = 0x9e3779b97f4a7c15ULL * (hilo->id + 1);
+    while (segundos() < c->fin){
+        for (size_t i = 0; i < 256; i++){
+            size_t indice = aleatorio(&estado) % c->cant_claves;
+            if (aleatorio(&estado) % 2 == 0){
+                if (!hash_concurrente_guardar(c->hash, c->claves[indice], dato_de(indice, hilo->id))) informar_error(c);
+            }else{
+                void* dato = hash_concurrente_borrar(c->hash, c->claves[indice]);
+                if (dato && indice_de(dato) != indice) informar_error(c);
+            }
+            hilo->operaciones ++;
+        }
+    }
+    return NULL;
+}
+
+static void* leer(void* extra){
+    hilo_t* hilo = extra;
+    compartido_t* c = hilo->compartido;
+    uint64_t estado = 0x2545f4914f6cdd1dULL * (hilo->id + 1);
+    char ausente[LARGO_MAX];
+    while (segundos() < c->fin){
+        for (size_t i = 0; i < 256; i++){
+            size_t indice = aleatorio(&estado) % c->cant_claves;
+            void* dato = hash_concurrente_obtener(c->hash, c->claves[indice]);
+            if (dato && indice_de(dato) != indice) informar_error(c);
+            hash_concurrente_pertenece(c->hash, c->claves[indice]);
+            // Misma longitud que una clave guardada, pero ausente.
+            memcpy(ausente, c->claves[indice], LARGO_MAX);
+            ausente[0] = '#';
+            if (hash_concurrente_obtener(c->hash, ausente) != NULL) informar_error(c);
+            hilo->operaciones ++;
+        }
+    }
+    return NULL;
+}
+
+static void ejecutar_fase(const fase_t* fase){
+    compartido_t c;
+    c.hash = hash_concurrente_crear(NULL);
+    VERIFICAR(c.hash);
+    c.cant_claves = fase->cant_claves;
+    c.claves = malloc(fase->cant_claves * sizeof(*c.claves));
+    VERIFICAR(c.claves);
+    // Claves cortas y largas: las largas ocupan memoria aparte que se libera al borrarlas.
+    for (size_t i = 0; i < fase->cant_claves; i++){
+        if (i % 2 == 0) snprintf(c.claves[i], LARGO_MAX, "k%zu", i);
+        else snprintf(c.claves[i], LARGO_MAX, "clave-concurrente-de-prueba-%zu", i);
+    }
+    c.errores = 0;
+    pthread_mutex_init(&c.mutex_errores, NULL);
+    c.fin = segundos() + SEGUNDOS_FASE;
+
+    hilo_t hilos[ESCRITORES + LECTORES];
+    for (size_t i = 0; i < ESCRITORES + LECTORES; i++){
+        hilos[i].compartido = &c;
+        hilos[i].id = i;
+        hilos[i].operaciones = 0;
+        VERIFICAR(pthread_create(&hilos[i].hilo, NULL, i < ESCRITORES ? escribir : leer, &hilos[i]) == 0);
+    }
+    size_t escrituras = 0, lecturas = 0;
+    for (size_t i = 0; i < ESCRITORES + LECTORES; i++){
+        pthread_join(hilos[i].hilo, NULL);
+        if (i < ESCRITORES) escrituras += hilos[i].operaciones;
+        else lecturas += hilos[i].operaciones;
+    }
+    printf("%s: %zu escrituras, %zu lecturas, %zu errores\n", fase->nombre, escrituras, lecturas, c.errores);
+    VERIFICAR(c.errores == 0);
+
+    // Sin hilos activos, la cantidad coincide con las claves presentes.
+    size_t presentes = 0;
+    for (size_t i = 0; i < fase->cant_claves; i++){
+        void* dato = hash_concurrente_obtener(c.hash, c.claves[i]);
+        VERIFICAR(hash_concurrente_pertenece(c.hash, c.claves[i]) == (dato != NULL));
+        if (dato){
+            VERIFICAR(indice_de(dato) == i);
+            presentes ++;
+        }
+    }
+    VERIFICAR(hash_concurrente_cantidad(c.hash) == presentes);
+
+    pthread_mutex_destroy(&c.mutex_errores);
+    hash_concurrente_destruir(c.hash);
+    free(c.claves);
+}
+
+int main(void){
+    fase_t fases[] = {
+        {"64 claves", 64},
+        {"50000 claves", 50000},
+    };
+    for (size_t i = 0; i < sizeof(fases) / sizeof(fases[0]); i++) ejecutar_fase(&fases[i]);
+
+    // Las opciones que no se pueden respetar se rechazan.
+    hash_opciones_t con_filtro = {.tasa_falsos_positivos = 0.01};
+    VERIFICAR(hash_concurrente_crear_con_opciones(NULL, &con_filtro) == NULL);
+    hash_opciones_t con_capacidad = {.capacidad = 100000, .politica = {.factor_carga_max = 0.5}};
+    hash_concurrente_t* hash = hash_concurrente_crear_con_opciones(NULL, &con_capacidad);
+    VERIFICAR(hash);
+    hash_concurrente_destruir(hash);
+    return 0;
+}
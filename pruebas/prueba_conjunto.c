@@ -0,0 +1,96 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_conjunto.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 5000
+#define LARGO_MAX 40
+
+// Cuenta las claves que se hashean, para verificar que las operaciones entre
+// conjuntos reutilizan los hashes guardados.
+static size_t hasheadas = 0;
+
+static uint64_t funcion_contada(const char* clave, size_t largo, uint64_t semilla){
+    hasheadas ++;
+    return hash_funcion_rapida(clave, largo, semilla);
+}
+
+static void clave_de(char* clave, size_t i){
+    // Claves cortas y largas, que se guardan fuera del campo.
+    snprintf(clave, LARGO_MAX, i % 2 ? "%zu" : "clave-larga-del-conjunto-%zu", i);
+}
+
+// a tiene los múltiplos de 2 y b los de 3, entre 0 y CANT_CLAVES.
+static void verificar_operaciones(const hash_conjunto_t* a, const hash_conjunto_t* b){
+    hash_conjunto_t* operaciones[] = {hash_conjunto_union(a, b), hash_conjunto_interseccion(a, b), hash_conjunto_diferencia(a, b)};
+    VERIFICAR(operaciones[0] && operaciones[1] && operaciones[2]);
+    VERIFICAR(hasheadas == 0);
+    char clave[LARGO_MAX];
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        clave_de(clave, i);
+        bool en_a = i % 2 == 0, en_b = i % 3 == 0;
+        VERIFICAR(hash_conjunto_pertenece(operaciones[0], clave) == (en_a || en_b));
+        VERIFICAR(hash_conjunto_pertenece(operaciones[1], clave) == (en_a && en_b));
+        VERIFICAR(hash_conjunto_pertenece(operaciones[2], clave) == (en_a && !en_b));
+    }
+    size_t multiplos_2 = (CANT_CLAVES + 1) / 2, multiplos_3 = (CANT_CLAVES + 2) / 3, multiplos_6 = (CANT_CLAVES + 5) / 6;
+    VERIFICAR(hash_conjunto_cantidad(operaciones[0]) == multiplos_2 + multiplos_3 - multiplos_6);
+    VERIFICAR(hash_conjunto_cantidad(operaciones[1]) == multiplos_6);
+    VERIFICAR(hash_conjunto_cantidad(operaciones[2]) == multiplos_2 - multiplos_6);
+    for (size_t i = 0; i < 3; i++) hash_conjunto_destruir(operaciones[i]);
+}
+
+int main(void){
+    // Dos conjuntos creados por separado, sin semilla: comparten la semilla por omisión.
+    hash_opciones_t opciones = {.funcion = funcion_contada};
+    hash_conjunto_t* a = hash_conjunto_crear_con_opciones(&opciones);
+    hash_conjunto_t* b = hash_conjunto_crear_con_opciones(&opciones);
+    VERIFICAR(a && b);
+    char clave[LARGO_MAX];
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        clave_de(clave, i);
+        if (i % 2 == 0) VERIFICAR(hash_conjunto_agregar(a, clave));
+        if (i % 3 == 0) VERIFICAR(hash_conjunto_agregar(b, clave));
+    }
+    VERIFICAR(hash_conjunto_agregar(a, "0") && hash_conjunto_quitar(a, "0") && !hash_conjunto_quitar(a, "0"));
+    hasheadas = 0;
+    verificar_operaciones(a, b);
+
+    // Los conjuntos derivados conservan la semilla de su operando.
+    hash_conjunto_t* copia = hash_conjunto_union(a, a);
+    VERIFICAR(copia);
+    hasheadas = 0;
+    verificar_operaciones(copia, b);
+
+    // Con semillas distintas el resultado es el mismo, aunque haya que recalcular los hashes.
+    hash_opciones_t otra_semilla = {.funcion = funcion_contada, .semilla = 42};
+    hash_conjunto_t* c = hash_conjunto_crear_con_opciones(&otra_semilla);
+    VERIFICAR(c);
+    for (size_t i = 0; i < CANT_CLAVES; i += 3){
+        clave_de(clave, i);
+        VERIFICAR(hash_conjunto_agregar(c, clave));
+    }
+    hasheadas = 0;
+    hash_conjunto_t* interseccion = hash_conjunto_interseccion(a, c);
+    VERIFICAR(interseccion && hash_conjunto_cantidad(interseccion) == (CANT_CLAVES + 5) / 6);
+    VERIFICAR(hasheadas > 0);
+
+    // Vaciar el conjunto achica la tabla y deja todas las claves afuera.
+    for (size_t i = 0; i < CANT_CLAVES; i += 2){
+        clave_de(clave, i);
+        VERIFICAR(hash_conjunto_quitar(copia, clave));
+    }
+    VERIFICAR(hash_conjunto_cantidad(copia) == 0);
+    hash_conjunto_iter_t* iter = hash_conjunto_iter_crear(copia);
+    VERIFICAR(iter && hash_conjunto_iter_al_final(iter));
+    hash_conjunto_iter_destruir(iter);
+
+    hash_conjunto_destruir(interseccion);
+    hash_conjunto_destruir(c);
+    hash_conjunto_destruir(copia);
+    hash_conjunto_destruir(b);
+    hash_conjunto_destruir(a);
+    return 0;
+}
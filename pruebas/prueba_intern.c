@@ -0,0 +1,168 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "abb.h"
+#include "hash.h"
+#include "intern.h"
+#include "pruebas.h"
+
+#define CANT_CADENAS 20000
+#define LARGO_MAX 48
+
+// Verifica que intern_t devuelve un único puntero por cadena, también para las
+// cadenas más grandes que un bloque, y que el hash y el abb que toman prestadas
+// sus claves no las liberan al destruirse. Conviene correrla también con
+// -fsanitize=address, que detecta si se lee una clave liberada.
+
+// Largos alrededor del bloque de intern.c (64 KiB) y de su límite para
+// cadenas grandes (un cuarto de bloque).
+static const size_t largos_grandes[] = {16383, 16384, 16385, 65535, 65536, 65537, 200000};
+#define CANT_GRANDES (sizeof(largos_grandes) / sizeof(largos_grandes[0]))
+
+static void cadena_de(char* cadena, size_t i){
+    // Cadenas cortas y largas: el hash guarda las cortas dentro de la tabla.
+    snprintf(cadena, LARGO_MAX, i % 2 ? "%zu" : "cadena-internada-numero-%zu", i);
+}
+
+static char* cadena_grande(size_t largo, char relleno){
+    char* cadena = malloc(largo + 1);
+    VERIFICAR(cadena);
+    memset(cadena, relleno, largo);
+    cadena[largo] = '\0';
+    return cadena;
+}
+
+static void probar_punteros(intern_t* intern, const char** canonicas, char** grandes, const char** canonicas_grandes){
+    char cadena[LARGO_MAX];
+    for (size_t i = 0; i < CANT_CADENAS; i++){
+        cadena_de(cadena, i);
+        canonicas[i] = intern_agregar(intern, cadena);
+        VERIFICAR(canonicas[i] && canonicas[i] != cadena && strcmp(canonicas[i], cadena) == 0);
+    }
+    for (size_t i = 0; i < CANT_GRANDES; i++){
+        grandes[i] = cadena_grande(largos_grandes[i], (char) ('a' + i));
+        canonicas_grandes[i] = intern_agregar(intern, grandes[i]);
+        VERIFICAR(canonicas_grandes[i] && strcmp(canonicas_grandes[i], grandes[i]) == 0);
+    }
+    VERIFICAR(intern_cantidad(intern) == CANT_CADENAS + CANT_GRANDES);
+
+    // La misma cadena, desde otra copia, da el mismo puntero, y no se agrega de nuevo.
+    for (size_t i = 0; i < CANT_CADENAS; i++){
+        cadena_de(cadena, i);
+        VERIFICAR(intern_agregar(intern, cadena) == canonicas[i]);
+        VERIFICAR(intern_buscar(intern, cadena) == canonicas[i]);
+    }
+    for (size_t i = 0; i < CANT_GRANDES; i++){
+        char* copia = cadena_grande(largos_grandes[i], (char) ('a' + i));
+        VERIFICAR(intern_agregar(intern, copia) == canonicas_grandes[i]);
+        free(copia);
+    }
+    VERIFICAR(intern_cantidad(intern) == CANT_CADENAS + CANT_GRANDES);
+    VERIFICAR(intern_buscar(intern, "no-internada") == NULL);
+    VERIFICAR(intern_buscar(intern, "") == NULL);
+    VERIFICAR(intern_agregar(intern, "") && strcmp(intern_buscar(intern, ""), "") == 0);
+
+    // Agregar más cadenas no mueve a las anteriores.
+    for (size_t i = 0; i < CANT_CADENAS; i++){
+        cadena_de(cadena, i);
+        VERIFICAR(strcmp(canonicas[i], cadena) == 0);
+    }
+    for (size_t i = 0; i < CANT_GRANDES; i++) VERIFICAR(strcmp(canonicas_grandes[i], grandes[i]) == 0);
+}
+
+// Las claves largas del hash son las del conjunto, y siguen valiendo después de destruirlo.
+static void probar_hash(intern_t* intern, const char** canonicas){
+    hash_opciones_t opciones = {.intern = intern};
+    hash_t* hash = hash_crear_con_opciones(NULL, &opciones);
+    VERIFICAR(hash);
+    char cadena[LARGO_MAX];
+    for (size_t i = 0; i < CANT_CADENAS; i++) VERIFICAR(hash_guardar(hash, canonicas[i], (void*) (uintptr_t) (i + 1)));
+    // Una clave que no estaba en el conjunto se agrega al guardarla.
+    const char* nueva = "clave-larga-que-no-estaba-internada";
+    VERIFICAR(hash_guardar(hash, nueva, NULL));
+    const char* canonica_nueva = intern_buscar(intern, nueva);
+    VERIFICAR(canonica_nueva);
+
+    hash_iter_t* iter = hash_iter_crear(hash);
+    VERIFICAR(iter);
+    size_t prestadas = 0;
+    for (; !hash_iter_al_final(iter); hash_iter_avanzar(iter)){
+        const char* clave = hash_iter_ver_actual(iter);
+        const char* canonica = intern_buscar(intern, clave);
+        VERIFICAR(canonica);
+        // Las claves de más de 15 caracteres (HASH_CLAVE_CORTA_MAX) no se copian.
+        if (strlen(clave) > 15){
+            VERIFICAR(clave == canonica);
+            prestadas ++;
+        }
+    }
+    hash_iter_destruir(iter);
+    VERIFICAR(prestadas == CANT_CADENAS / 2 + 1);
+    for (size_t i = 0; i < CANT_CADENAS; i++){
+        cadena_de(cadena, i);
+        VERIFICAR(hash_obtener(hash, cadena) == (void*) (uintptr_t) (i + 1));
+    }
+    // Borrar y destruir no liberan las claves del conjunto.
+    for (size_t i = 0; i < CANT_CADENAS; i += 4) VERIFICAR(hash_borrar(hash, canonicas[i]) == (void*) (uintptr_t) (i + 1));
+    hash_destruir(hash);
+    for (size_t i = 0; i < CANT_CADENAS; i++){
+        cadena_de(cadena, i);
+        VERIFICAR(strcmp(canonicas[i], cadena) == 0);
+    }
+    VERIFICAR(strcmp(canonica_nueva, nueva) == 0);
+}
+
+// El abb toma prestadas todas sus claves, también las grandes.
+static void probar_abb(intern_t* intern, const char** canonicas, char** grandes, const char** canonicas_grandes){
+    abb_t* abb = abb_crear_con_intern(strcmp, NULL, intern);
+    VERIFICAR(abb);
+    char cadena[LARGO_MAX];
+    for (size_t i = 0; i < CANT_CADENAS; i++){
+        cadena_de(cadena, i);
+        VERIFICAR(abb_guardar(abb, cadena, (void*) (uintptr_t) (i + 1)));
+    }
+    for (size_t i = 0; i < CANT_GRANDES; i++) VERIFICAR(abb_guardar(abb, grandes[i], NULL));
+    const char* nueva = "otra-clave-que-no-estaba";
+    VERIFICAR(abb_guardar(abb, nueva, NULL));
+    const char* canonica_nueva = intern_buscar(intern, nueva);
+    VERIFICAR(canonica_nueva);
+
+    abb_iter_t* iter = abb_iter_in_crear(abb);
+    VERIFICAR(iter);
+    size_t vistas = 0;
+    for (; !abb_iter_in_al_final(iter); abb_iter_in_avanzar(iter)){
+        const char* clave = abb_iter_in_ver_actual(iter);
+        VERIFICAR(clave == intern_buscar(intern, clave));
+        vistas ++;
+    }
+    abb_iter_in_destruir(iter);
+    VERIFICAR(vistas == CANT_CADENAS + CANT_GRANDES + 1);
+
+    for (size_t i = 0; i < CANT_CADENAS; i += 4) VERIFICAR(abb_borrar(abb, canonicas[i]) == (void*) (uintptr_t) (i + 1));
+    abb_destruir(abb);
+    for (size_t i = 0; i < CANT_CADENAS; i++){
+        cadena_de(cadena, i);
+        VERIFICAR(strcmp(canonicas[i], cadena) == 0);
+    }
+    for (size_t i = 0; i < CANT_GRANDES; i++) VERIFICAR(strcmp(canonicas_grandes[i], grandes[i]) == 0);
+    VERIFICAR(strcmp(canonica_nueva, nueva) == 0);
+}
+
+int main(void){
+    intern_t* intern = intern_crear();
+    const char** canonicas = malloc(CANT_CADENAS * sizeof(char*));
+    VERIFICAR(intern && canonicas);
+    char* grandes[CANT_GRANDES];
+    const char* canonicas_grandes[CANT_GRANDES];
+
+    probar_punteros(intern, canonicas, grandes, canonicas_grandes);
+    probar_hash(intern, canonicas);
+    probar_abb(intern, canonicas, grandes, canonicas_grandes);
+
+    intern_destruir(intern);
+    for (size_t i = 0; i < CANT_GRANDES; i++) free(grandes[i]);
+    free(canonicas);
+    return 0;
+}
@@ -0,0 +1,141 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hash.h"
+#include "hash_mmap.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 1000
+#define LARGO_MAX 32
+#define TAM_CABECERA 48 // sizeof(cabecera_t) en hash_mmap.c.
+#define TAM_RANURA 32   // sizeof(ranura_t) en hash_mmap.c.
+
+// Serializa un entero en un buffer que se reutiliza en cada llamado.
+static const void* serializar_en_buffer(const void* dato, size_t* largo){
+    static char buffer[LARGO_MAX];
+    *largo = (size_t) snprintf(buffer, sizeof(buffer), "valor %zu", (size_t) (uintptr_t) dato) + 1;
+    return buffer;
+}
+
+static void verificar_imagen(const char* ruta, size_t cant){
+    hash_mmap_t* imagen = hash_mmap_abrir(ruta);
+    VERIFICAR(imagen);
+    VERIFICAR(hash_mmap_cantidad(imagen) == cant);
+    char clave[LARGO_MAX], esperado[LARGO_MAX];
+    for (size_t i = 0; i < cant; i++){
+        snprintf(clave, sizeof(clave), "clave %zu", i);
+        snprintf(esperado, sizeof(esperado), "valor %zu", i);
+        size_t largo;
+        const char* dato = hash_mmap_obtener(imagen, clave, &largo);
+        VERIFICAR(dato && largo == strlen(esperado) + 1 && strcmp(dato, esperado) == 0);
+    }
+    VERIFICAR(!hash_mmap_pertenece(imagen, "ausente"));
+    hash_mmap_cerrar(imagen);
+}
+
+// Lee el archivo entero a memoria. Devuelve su largo en 'largo'.
+static char* leer_archivo(const char* ruta, size_t* largo){
+    FILE* archivo = fopen(ruta, "rb");
+    VERIFICAR(archivo);
+    fseek(archivo, 0, SEEK_END);
+    *largo = (size_t) ftell(archivo);
+    fseek(archivo, 0, SEEK_SET);
+    char* bytes = malloc(*largo);
+    VERIFICAR(bytes && fread(bytes, 1, *largo, archivo) == *largo);
+    fclose(archivo);
+    return bytes;
+}
+
+// Escribe los bytes en la ruta y verifica que hash_mmap_abrir los rechace.
+static void verificar_rechazo(const char* ruta, const char* bytes, size_t largo){
+    FILE* archivo = fopen(ruta, "wb");
+    VERIFICAR(archivo && fwrite(bytes, 1, largo, archivo) == largo);
+    fclose(archivo);
+    VERIFICAR(hash_mmap_abrir(ruta) == NULL);
+}
+
+int main(void){
+    char ruta[] = "/tmp/prueba_mmap_XXXXXX";
+    int fd = mkstemp(ruta);
+    VERIFICAR(fd >= 0);
+    close(fd);
+
+    hash_t* hash = hash_crear(NULL);
+    VERIFICAR(hash);
+    char clave[LARGO_MAX];
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        snprintf(clave, sizeof(clave), "clave %zu", i);
+        VERIFICAR(hash_guardar(hash, clave, (void*) (uintptr_t) i));
+    }
+
+    // El serializador puede reutilizar su buffer.
+    VERIFICAR(hash_serializar(hash, ruta, serializar_en_buffer));
+    verificar_imagen(ruta, CANT_CLAVES);
+
+    // Reemplazar la imagen no afecta a quien tiene mapeada la anterior.
+    hash_mmap_t* anterior = hash_mmap_abrir(ruta);
+    VERIFICAR(anterior);
+    hash_t* chico = hash_crear(NULL);
+    VERIFICAR(chico && hash_guardar(chico, "clave 0", (void*) 0));
+    VERIFICAR(hash_serializar(chico, ruta, serializar_en_buffer));
+    VERIFICAR(hash_mmap_cantidad(anterior) == CANT_CLAVES);
+    size_t largo_dato;
+    const char* dato = hash_mmap_obtener(anterior, "clave 999", &largo_dato);
+    VERIFICAR(dato && strcmp(dato, "valor 999") == 0);
+    hash_mmap_cerrar(anterior);
+    verificar_imagen(ruta, 1);
+    hash_destruir(chico);
+
+    // Imágenes corruptas: desplazamientos fuera del archivo, una clave sin
+    // terminar, una tabla sin posiciones vacías y un archivo vacío.
+    VERIFICAR(hash_serializar(hash, ruta, serializar_en_buffer));
+    size_t largo;
+    char* original = leer_archivo(ruta, &largo);
+    uint64_t tam;
+    memcpy(&tam, original + 32, sizeof(tam));
+    char* ranuras = original + TAM_CABECERA;
+    size_t ocupada = 0;
+    uint64_t desplazamiento;
+    do{
+        memcpy(&desplazamiento, ranuras + ocupada * TAM_RANURA + 8, sizeof(desplazamiento));
+    }while (desplazamiento == 0 && ++ocupada < tam);
+    VERIFICAR(ocupada < tam);
+
+    char* corrupto = malloc(largo);
+    VERIFICAR(corrupto);
+    uint64_t fuera = largo + 4096;
+    for (size_t campo = 8; campo <= 16; campo += 8){
+        memcpy(corrupto, original, largo);
+        memcpy(corrupto + TAM_CABECERA + ocupada * TAM_RANURA + campo, &fuera, sizeof(fuera));
+        verificar_rechazo(ruta, corrupto, largo);
+    }
+    memcpy(corrupto, original, largo);
+    uint32_t largo_enorme = UINT32_MAX - 1;
+    memcpy(corrupto + TAM_CABECERA + ocupada * TAM_RANURA + 24, &largo_enorme, sizeof(largo_enorme));
+    verificar_rechazo(ruta, corrupto, largo);
+    memcpy(corrupto, original, largo);
+    memset(corrupto + desplazamiento, 'x', 16);
+    verificar_rechazo(ruta, corrupto, largo);
+    memcpy(corrupto, original, largo);
+    for (size_t i = 0; i < tam; i++){
+        memcpy(corrupto + TAM_CABECERA + i * TAM_RANURA, original + TAM_CABECERA + ocupada * TAM_RANURA, TAM_RANURA);
+    }
+    verificar_rechazo(ruta, corrupto, largo);
+
+    verificar_rechazo(ruta, original, 0);
+
+    // La imagen sin modificar sigue siendo válida.
+    FILE* archivo = fopen(ruta, "wb");
+    VERIFICAR(archivo && fwrite(original, 1, largo, archivo) == largo);
+    fclose(archivo);
+    verificar_imagen(ruta, CANT_CLAVES);
+
+    free(corrupto);
+    free(original);
+    hash_destruir(hash);
+    unlink(ruta);
+    return 0;
+}
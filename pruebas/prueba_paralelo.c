@@ -0,0 +1,126 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "hash.h"
+#include "hash_paralelo.h"
+#include "pruebas.h"
+
+// Con 6965 claves la última inserción agranda la tabla y deja una migración en
+// curso (ver prueba_asignaciones_hash), así que los rangos abarcan las dos tablas.
+#define CANT_CLAVES 6965
+#define LARGO_MAX 48
+
+// Cuenta cuántas veces se visitó cada clave. El dato de la clave i es i + 1.
+typedef struct visitas{
+    pthread_mutex_t mutex;
+    size_t veces[CANT_CLAVES];
+    size_t total;
+    size_t cortar_en; // visitar devuelve false desde esta visita (0: nunca).
+}visitas_t;
+
+static void clave_de(char* clave, size_t i){
+    // Claves cortas y largas, que se guardan fuera de la tabla.
+    snprintf(clave, LARGO_MAX, i % 2 ? "%zu" : "clave-larga-del-recorrido-%zu", i);
+}
+
+static bool visitar(const char* clave, void* dato, void* extra){
+    visitas_t* visitas = extra;
+    size_t i = (size_t) (uintptr_t) dato - 1;
+    char esperada[LARGO_MAX];
+    clave_de(esperada, i);
+    VERIFICAR(i < CANT_CLAVES && strcmp(clave, esperada) == 0);
+    pthread_mutex_lock(&visitas->mutex);
+    visitas->veces[i] ++;
+    size_t total = ++ visitas->total;
+    pthread_mutex_unlock(&visitas->mutex);
+    return visitas->cortar_en == 0 || total < visitas->cortar_en;
+}
+
+static void reiniciar(visitas_t* visitas, size_t cortar_en){
+    memset(visitas->veces, 0, sizeof(visitas->veces));
+    visitas->total = 0;
+    visitas->cortar_en = cortar_en;
+}
+
+static void verificar_una_vez(const visitas_t* visitas, size_t cantidad){
+    for (size_t i = 0; i < cantidad; i++) VERIFICAR(visitas->veces[i] == 1);
+    VERIFICAR(visitas->total == cantidad);
+}
+
+// Los iteradores de las partes 0 a partes - 1 son disjuntos y cubren todas las claves.
+static void verificar_rangos(const hash_t* hash, size_t partes, visitas_t* visitas){
+    reiniciar(visitas, 0);
+    for (size_t parte = 0; parte < partes; parte++){
+        hash_iter_t* iter = hash_iter_rango_crear(hash, parte, partes);
+        VERIFICAR(iter);
+        for (; !hash_iter_al_final(iter); hash_iter_avanzar(iter)){
+            VERIFICAR(visitar(hash_iter_ver_actual(iter), hash_iter_ver_dato(iter), visitas));
+        }
+        hash_iter_destruir(iter);
+    }
+    verificar_una_vez(visitas, hash_cantidad(hash));
+    VERIFICAR(hash_iter_rango_crear(hash, partes, partes) == NULL);
+}
+
+int main(void){
+    visitas_t* visitas = malloc(sizeof(visitas_t));
+    VERIFICAR(visitas);
+    pthread_mutex_init(&visitas->mutex, NULL);
+    hash_t* hash = hash_crear(NULL);
+    VERIFICAR(hash);
+
+    // Hash vacío.
+    reiniciar(visitas, 0);
+    VERIFICAR(hash_para_cada_paralelo(hash, 4, visitar, visitas));
+    VERIFICAR(visitas->total == 0);
+
+    char clave[LARGO_MAX];
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        clave_de(clave, i);
+        VERIFICAR(hash_guardar(hash, clave, (void*) (uintptr_t) (i + 1)));
+    }
+    hash_estadisticas_t estadisticas = hash_estadisticas(hash);
+    VERIFICAR(estadisticas.tam_anterior > 0 && estadisticas.pendientes > 0);
+
+    // Más partes que posiciones deja partes vacías.
+    size_t partes[] = {1, 2, 3, 7, 64, 1000, estadisticas.tam + estadisticas.tam_anterior + 5};
+    for (size_t i = 0; i < sizeof(partes) / sizeof(partes[0]); i++) verificar_rangos(hash, partes[i], visitas);
+
+    size_t hilos[] = {0, 1, 2, 3, 8};
+    for (size_t i = 0; i < sizeof(hilos) / sizeof(hilos[0]); i++){
+        size_t cant_hilos = hilos[i] ? hilos[i] : (size_t) sysconf(_SC_NPROCESSORS_ONLN);
+        reiniciar(visitas, 0);
+        VERIFICAR(hash_para_cada_paralelo(hash, hilos[i], visitar, visitas));
+        verificar_una_vez(visitas, CANT_CLAVES);
+
+        // Desde la visita número cortar_en, visitar devuelve false y el hilo que
+        // la hizo no visita otra clave: hay a lo sumo una visita así por hilo.
+        reiniciar(visitas, 1);
+        VERIFICAR(!hash_para_cada_paralelo(hash, hilos[i], visitar, visitas));
+        VERIFICAR(visitas->total >= 1 && visitas->total <= cant_hilos);
+        reiniciar(visitas, CANT_CLAVES / 2);
+        VERIFICAR(!hash_para_cada_paralelo(hash, hilos[i], visitar, visitas));
+        VERIFICAR(visitas->total >= CANT_CLAVES / 2 && visitas->total < CANT_CLAVES / 2 + cant_hilos);
+        for (size_t j = 0; j < CANT_CLAVES; j++) VERIFICAR(visitas->veces[j] <= 1);
+    }
+
+    // Terminada la migración, los rangos siguen cubriendo todas las claves.
+    for (size_t i = 0; i < CANT_CLAVES; i += 2){
+        clave_de(clave, i);
+        VERIFICAR(hash_borrar(hash, clave) == (void*) (uintptr_t) (i + 1));
+    }
+    VERIFICAR(hash_estadisticas(hash).pendientes == 0);
+    reiniciar(visitas, 0);
+    VERIFICAR(hash_para_cada_paralelo(hash, 4, visitar, visitas));
+    VERIFICAR(visitas->total == CANT_CLAVES / 2);
+    for (size_t i = 0; i < CANT_CLAVES; i++) VERIFICAR(visitas->veces[i] == i % 2);
+
+    hash_destruir(hash);
+    pthread_mutex_destroy(&visitas->mutex);
+    free(visitas);
+    return 0;
+}
@@ -0,0 +1,142 @@
+#define  _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_u64.h"
+#include "pruebas.h"
+
+#define CANT_CLAVES 50000
+
+// Prueba hash_u64_t con claves aleatorias más 0 y UINT64_MAX, que no pueden
+// tener nada de especial en la tabla. El dato de cada clave es una copia de la
+// clave en memoria dinámica, y se cuentan las llamadas a destruir_dato.
+
+static size_t destruidos = 0;
+
+static void destruir(void* dato){
+    destruidos ++;
+    free(dato);
+}
+
+// xorshift64 recorre todos los valores distintos de 0 sin repetir, así que
+// cada llamada da una clave nueva.
+static uint64_t aleatorio(uint64_t* estado){
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static uint64_t* dato_de(uint64_t clave){
+    uint64_t* dato = malloc(sizeof(uint64_t));
+    VERIFICAR(dato);
+    *dato = clave;
+    return dato;
+}
+
+static int comparar_claves(const void* a, const void* b){
+    uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+// Recorre el hash con el iterador y verifica que visita cada clave de 'claves'
+// (ordenadas) exactamente una vez, con su dato.
+static void verificar_iterador(const hash_u64_t* hash, const uint64_t* claves, size_t cant){
+    unsigned char* vistas = calloc(cant, 1);
+    VERIFICAR(vistas);
+    hash_u64_iter_t* iter = hash_u64_iter_crear(hash);
+    VERIFICAR(iter);
+    size_t total = 0;
+    for (; !hash_u64_iter_al_final(iter); hash_u64_iter_avanzar(iter)){
+        uint64_t clave = hash_u64_iter_ver_actual(iter);
+        const uint64_t* encontrada = bsearch(&clave, claves, cant, sizeof(uint64_t), comparar_claves);
+        VERIFICAR(encontrada);
+        VERIFICAR(*(uint64_t*) hash_u64_iter_ver_dato(iter) == clave);
+        VERIFICAR(vistas[encontrada - claves] == 0);
+        vistas[encontrada - claves] = 1;
+        total ++;
+    }
+    VERIFICAR(total == cant && total == hash_u64_cantidad(hash));
+    VERIFICAR(hash_u64_iter_ver_actual(iter) == 0 && hash_u64_iter_ver_dato(iter) == NULL);
+    VERIFICAR(!hash_u64_iter_avanzar(iter));
+    hash_u64_iter_destruir(iter);
+    free(vistas);
+}
+
+int main(void){
+    uint64_t* claves = malloc((CANT_CLAVES + 2) * sizeof(uint64_t));
+    VERIFICAR(claves);
+    uint64_t estado = 88172645463325252ULL;
+    claves[0] = 0;
+    claves[1] = UINT64_MAX;
+    for (size_t i = 2; i < CANT_CLAVES + 2; i++){
+        do claves[i] = aleatorio(&estado); while (claves[i] == UINT64_MAX);
+    }
+    size_t cant = CANT_CLAVES + 2;
+
+    hash_u64_t* hash = hash_u64_crear(destruir);
+    VERIFICAR(hash);
+    VERIFICAR(!hash_u64_pertenece(hash, 0) && hash_u64_obtener(hash, 0) == NULL);
+    for (size_t i = 0; i < cant; i++) VERIFICAR(hash_u64_guardar(hash, claves[i], dato_de(claves[i])));
+    VERIFICAR(hash_u64_cantidad(hash) == cant);
+    VERIFICAR(destruidos == 0);
+    for (size_t i = 0; i < cant; i++){
+        VERIFICAR(hash_u64_pertenece(hash, claves[i]));
+        VERIFICAR(*(uint64_t*) hash_u64_obtener(hash, claves[i]) == claves[i]);
+    }
+
+    // Reemplazar el dato destruye el anterior y no cambia la cantidad.
+    for (size_t i = 0; i < 4; i++) VERIFICAR(hash_u64_guardar(hash, claves[i], dato_de(claves[i])));
+    VERIFICAR(destruidos == 4);
+    VERIFICAR(hash_u64_cantidad(hash) == cant);
+
+    // Claves ausentes: las siguientes del generador, que no se repiten.
+    for (size_t i = 0; i < CANT_CLAVES; i++){
+        uint64_t ausente = aleatorio(&estado);
+        if (ausente == UINT64_MAX) continue;
+        VERIFICAR(!hash_u64_pertenece(hash, ausente));
+        VERIFICAR(hash_u64_obtener(hash, ausente) == NULL);
+        VERIFICAR(hash_u64_borrar(hash, ausente) == NULL);
+    }
+    VERIFICAR(destruidos == 4);
+    VERIFICAR(hash_u64_cantidad(hash) == cant);
+
+    qsort(claves, cant, sizeof(uint64_t), comparar_claves);
+    verificar_iterador(hash, claves, cant);
+
+    // Borrar devuelve el dato sin destruirlo. Se borran las claves de posición
+    // impar, entre ellas UINT64_MAX, la última.
+    size_t quedan = 0;
+    for (size_t i = 0; i < cant; i++){
+        if (i % 2 == 0){
+            claves[quedan++] = claves[i];
+            continue;
+        }
+        uint64_t* dato = hash_u64_borrar(hash, claves[i]);
+        VERIFICAR(dato && *dato == claves[i]);
+        free(dato);
+        VERIFICAR(!hash_u64_pertenece(hash, claves[i]));
+        VERIFICAR(hash_u64_borrar(hash, claves[i]) == NULL);
+    }
+    VERIFICAR(destruidos == 4);
+    VERIFICAR(hash_u64_cantidad(hash) == quedan);
+    VERIFICAR(!hash_u64_pertenece(hash, UINT64_MAX) && hash_u64_pertenece(hash, 0));
+    for (size_t i = 0; i < quedan; i++) VERIFICAR(*(uint64_t*) hash_u64_obtener(hash, claves[i]) == claves[i]);
+    verificar_iterador(hash, claves, quedan);
+
+    // Destruir el hash destruye los datos que quedan.
+    hash_u64_destruir(hash);
+    VERIFICAR(destruidos == 4 + quedan);
+
+    // Sin destruir_dato, destruir el hash no libera los datos (que acá no son
+    // bloques propios: liberarlos haría fallar al programa).
+    hash = hash_u64_crear_con_capacidad(NULL, quedan);
+    VERIFICAR(hash);
+    for (size_t i = 0; i < quedan; i++) VERIFICAR(hash_u64_guardar(hash, claves[i], &claves[i]));
+    VERIFICAR(hash_u64_guardar(hash, 0, &claves[0]));
+    hash_u64_destruir(hash);
+
+    free(claves);
+    return 0;
+}
@@ -0,0 +1,27 @@
+#ifndef PRUEBAS_H
+#define PRUEBAS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Utilidades comunes a las pruebas y los benchmarks. Los programas deben
+ * definir _POSIX_C_SOURCE antes de incluirlo.
+ */
+
+// Si la condición no se cumple, informa dónde y termina el programa con error.
+#define VERIFICAR(condicion) do{                                                   \
+    if (!(condicion)){                                                             \
+        fprintf(stderr, "%s:%d: falló %s\n", __FILE__, __LINE__, #condicion);      \
+        exit(EXIT_FAILURE);                                                        \
+    }                                                                              \
+}while (0)
+
+// Devuelve los segundos de un reloj monótono, para medir intervalos.
+static inline double segundos(void){
+    struct timespec ahora;
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (double) ahora.tv_sec + (double) ahora.tv_nsec / 1e9;
+}
+
+#endif // PRUEBAS_H